@@ -4,6 +4,45 @@
 #include <algorithm>
 #include <limits>
 #include <iomanip>
+#include <deque>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <queue>
+#include <set>
+#include <memory>
+#include <functional>
+#include <random>
+#include <bitset>
+#include <chrono>
+#include <coroutine>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include <map>
+#include <cstdint>
+#include <cctype>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+#else
+#include <dlfcn.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+#include "scheduler_plugin.h"
 
 // Configuration constants
 const int QUANTUM = 4;                    // Time quantum for Round Robin algorithm
@@ -14,18 +53,258 @@ const int MAX_PRIORITY = 3;               // Maximum priority level
 const int MIN_PRIORITY = 1;               // Minimum priority level
 const int NUM_QUEUES = 3;                 // Number of queues for multilevel scheduling
 
+// Multi-core simulation constants
+const int NUM_SOCKETS = 2;                      // Sockets in the simulated machine
+const int CORES_PER_SOCKET = 4;                 // Physical cores per socket
+const int THREADS_PER_CORE = 2;                 // SMT (hyperthread) siblings per core
+const int PROCESSES_PER_CPU = 3;                // Processes generated per logical CPU for multi-core runs
+const double SMT_SIBLING_SLOWDOWN = 0.35;       // Throughput lost while the sibling thread is busy
+const double COLD_CACHE_SLOWDOWN = 0.5;         // Throughput lost with a completely cold LLC
+const double CACHE_WARMUP_RATE = 0.25;          // LLC warmth gained per tick on a CPU
+const double CACHE_WARMTH_DECAY = 0.15;         // Fraction of LLC warmth lost per tick off-CPU
+const double SAME_SOCKET_WARMTH_KEPT = 0.7;     // Warmth kept when moving to another core on the socket
+const int MIGRATION_COST_SAME_SOCKET = 1;       // Stall ticks for a migration within a socket
+const int MIGRATION_COST_CROSS_SOCKET = 4;      // Stall ticks for a migration across sockets
+const size_t CROSS_SOCKET_IMBALANCE = 2;        // Minimum remote queue length before stealing across sockets
+const size_t CROSS_NODE_IMBALANCE = 2;          // Minimum remote queue length before stealing across NUMA nodes
+const double REMOTE_MEMORY_PENALTY = 0.3;       // Default throughput lost running away from the home node
+const int TOPOLOGY_MAX_COUNT = 1024;            // Largest socket, node, core or thread count a topology file may give
+const int TOPOLOGY_MAX_CPUS = 4096;             // Largest number of logical CPUs a topology file may describe
+const int NUMA_MIGRATE_AFTER = 8;               // Remote ticks before NUMA balancing moves a process's memory
+const int NUMA_PAGE_MIGRATION_COST = 3;         // Stall ticks to migrate a process's pages to a new node
+
+// Topology distances between logical CPUs
+const int DISTANCE_SAME_CPU = 0;
+const int DISTANCE_SAME_CORE = 1;
+const int DISTANCE_SAME_SOCKET = 2;
+const int DISTANCE_CROSS_SOCKET = 3;
+
+// Hierarchical fair-share constants
+const int FAIR_SHARE_DEFAULT_SHARES = 1024;     // Weight of a group with default shares
+const double FAIR_SHARE_PERIOD = 20.0;          // Bandwidth enforcement period for group quotas
+
+// Hypervisor simulation constants
+const int HYPERVISOR_VMS = 4;                   // Guest virtual machines
+const int VCPUS_PER_VM = 4;                     // Virtual CPUs per guest
+const int PROCESSES_PER_VM = 12;                // Processes generated per guest
+const int HOST_QUANTUM = 3;                     // Host time slice for a vCPU on a pCPU
+const int HOST_MAX_OVERCOMMIT = 4;              // Largest vCPU:pCPU ratio in the sweep
+const double LOCK_REQUEST_PROBABILITY = 0.2;    // Chance per running tick that a process takes the guest lock
+const int LOCK_HOLD_TICKS = 3;                  // Length of a guest critical section
+const unsigned HYPERVISOR_SEED = 12345;         // Seed shared by every overcommit level
+
+// Gang scheduling constants
+const int MAX_GANG_CPUS = 256;                  // Width of the CPU bitsets in the Ousterhout matrix
+const int GANG_JOB_COUNT = 24;                  // Parallel jobs generated per run
+const int GANG_SLOT_LENGTH = 4;                 // Ticks each matrix row runs before rotating
+const int GANG_MAX_SLOTS = 8;                   // Rows in the matrix (multiprogramming level)
+const int GANG_BARRIER_INTERVAL = 2;            // Ticks of work between thread barriers
+
+// Disk I/O scheduling constants (times in milliseconds)
+const int DISK_REQUEST_COUNT = 2000;            // Requests generated per run
+const int DISK_PROCESSES = 4;                   // Processes issuing I/O
+const long DISK_CYLINDERS = 10000;              // Cylinders on the simulated disk
+const long DISK_BLOCKS_PER_CYLINDER = 64;       // Blocks per cylinder
+const int DISK_MAX_REQUEST_BLOCKS = 16;         // Largest request size in blocks
+const double DISK_MEAN_INTERARRIVAL = 6.5;      // Mean time between request submissions
+const double DISK_SEEK_BASE = 1.0;              // Fixed cost of any seek
+const double DISK_SEEK_FACTOR = 0.05;           // Seek cost per sqrt(cylinder distance)
+const double DISK_ROTATIONAL_LATENCY = 2.0;     // Average rotational delay (15k RPM)
+const double DISK_TRANSFER_PER_BLOCK = 0.01;    // Transfer time per block
+const double DEADLINE_READ_EXPIRE = 500.0;      // Deadline scheduler read expiry
+const double DEADLINE_WRITE_EXPIRE = 5000.0;    // Deadline scheduler write expiry
+const int DEADLINE_FIFO_BATCH = 16;             // Requests dispatched per sorted batch
+const int DEADLINE_WRITES_STARVED = 2;          // Read batches allowed before writes must be served
+const int BFQ_MAX_BUDGET = 256;                 // Blocks served per BFQ activation
+
+// Packet scheduling constants (times in microseconds)
+const int PACKET_FLOWS = 8;                     // Flows generated per run
+const long DEFAULT_PACKET_COUNT = 1000000;      // Packets simulated when no count is given
+const double LINK_RATE = 1250.0;                // Link speed in bytes per microsecond (10 Gbit/s)
+const double PACKET_OFFERED_LOAD = 1.1;         // Combined offered load relative to the link rate
+const int PACKET_MIN_SIZE = 64;                 // Smallest mean packet size of a flow in bytes
+const int PACKET_MAX_SIZE = 1500;               // Largest mean packet size of a flow in bytes
+const long PACKET_QUEUE_LIMIT = 1000;           // Per-flow queue limit before tail drop
+const long PACKET_QUEUE_LIMIT_POW2 = 1024;      // Ring buffer capacity (power of two >= limit)
+const long DRR_QUANTUM = 1500;                  // DRR credit per round for weight 1, in bytes
+
+// Latency histogram layout
+const int HISTOGRAM_MIN_EXPONENT = -20;         // Smallest distinguished value is 2^-20
+const int HISTOGRAM_OCTAVES = 64;               // Powers of two covered
+const int HISTOGRAM_SUB_BUCKETS = 32;           // Linear buckets per power of two (~3% error)
+
+// Paging simulation constants
+const int PAGE_FRAMES = 64;                     // Physical frames shared by all processes
+const int MIN_WORKING_SET = 6;                  // Smallest working set in pages
+const int MAX_WORKING_SET = 16;                 // Largest working set in pages
+const int FOOTPRINT_FACTOR = 3;                 // Footprint as a multiple of the working set
+const double PAGE_LOCALITY = 0.95;              // Share of references that hit the working set
+const int PAGE_FAULT_SERVICE = 8;               // Ticks for the paging device to load a page
+const int PAGING_TICKS_PER_BURST = 20;          // Memory references per unit of burst time
+const int PAGING_PROCESS_COUNT = 12;            // Processes generated for paging runs
+const size_t PAGING_MPL_STEP = 2;               // Multiprogramming level increment in the sweep
+
+// Timer modeling constants (milliseconds)
+const double TIMER_TICK_COST = 0.005;           // CPU time of a periodic tick interrupt
+const double HRTIMER_PROGRAM_COST = 0.0005;     // Arming a one-shot high-resolution timer
+const double HRTIMER_EXPIRY_COST = 0.003;       // Handling a one-shot timer interrupt
+const double TIMER_OFFERED_LOAD = 0.8;          // Offered load of the timer comparison workload
+const int TIMER_PROCESS_COUNT = 5000;           // Arrivals simulated per timer mode
+
+// Admission control constants
+const int ADMISSION_PROCESS_COUNT = 5000;       // Arrivals simulated per offered load
+const double ADMISSION_LATENCY_OBJECTIVE = 60;  // Turnaround a process must meet to count as goodput
+const int ADMISSION_QUEUE_CAP = 4;              // Waiting processes allowed by the queue cap
+const double ADMISSION_TOKEN_RATE = 0.9;        // Token bucket rate as a fraction of CPU capacity
+const double ADMISSION_TOKEN_BUCKET = 5;        // Token bucket depth (burst allowance)
+const double ADMISSION_CODEL_TARGET = 20;       // Acceptable standing queueing delay
+const double ADMISSION_CODEL_INTERVAL = 100;    // Time above target before shedding starts
+
+// Interrupt load constants (fractions of a tick)
+const double SOFTIRQ_INLINE_BUDGET = 0.2;       // Softirq work run on interrupt exit before deferring
+const double KSOFTIRQD_SHARE = 0.5;             // Share of a busy CPU ksoftirqd gets against a process
+const unsigned IRQ_SEED = 4242;                 // Seed for interrupt arrivals
+
+// Green-thread executor constants
+const double EXECUTOR_TIME_UNIT_MS = 2.0;       // Wall-clock milliseconds per unit of burst time
+const long EXECUTOR_CHUNK = 4096;               // Kernel iterations between cooperative preemption points
+const int EXECUTOR_MAX_WORKERS = 4;             // Worker threads used for the parallel run
+
+// Behavioral workload constants
+const size_t FRAME_POOL_GRANULE = 64;           // Coroutine frame size classes, in bytes
+const size_t FRAME_POOL_CLASSES = 32;           // Size classes pooled (larger frames use the heap)
+const int BEHAVIOR_PROCESS_COUNT = 20000;       // Processes submitted per policy
+const double BEHAVIOR_ARRIVAL_RATE = 0.08;      // Mean arrivals per time unit
+const int BEHAVIOR_TABLE_LOCKS = 4;             // Table locks shared by database writers
+const unsigned BEHAVIOR_SEED = 2024;            // Seed shared by every policy run
+
+// Optimal schedule solver constants
+const int BNB_DEFAULT_PROCESSES = 20;           // Processes per sampled workload
+const int BNB_MAX_PROCESSES = 30;               // Largest instance the solver accepts
+const int BNB_SAMPLES = 10;                     // Workloads solved per analysis
+const double BNB_OFFERED_LOAD = 0.9;            // Offered load of the sampled workloads
+const long BNB_NODE_LIMIT = 20000000;           // Nodes searched before giving up on a proof
+const size_t BNB_MEMO_LIMIT = 2000000;          // States remembered per solver thread
+const int BNB_SPLIT_DEPTH = 2;                  // Levels expanded up front to feed the threads
+const int BNB_MAX_THREADS = 8;                  // Solver threads
+const unsigned BNB_SEED = 777;                  // Seed of the first sampled workload
+
+// Analytic prediction constants
+const int ANALYTIC_PROCESS_COUNT = 50000;       // Arrivals simulated per configuration
+const double ANALYTIC_LOADS[] = {0.5, 0.7, 0.8, 0.9};   // Offered loads in the sweep
+const double ANALYTIC_DIVERGENCE = 0.15;        // Relative error beyond which a simulation is flagged
+const double ANALYTIC_PRUNE_FACTOR = 1.5;       // Predicted wait above this multiple of the best is skipped
+const unsigned ANALYTIC_SEED = 31337;           // Seed shared by every configuration
+
+// Variance reduction constants
+const int VR_REPLICATIONS = 100;               // Workloads per policy and method
+const int VR_PROCESS_COUNT = 200;               // Processes per replication
+const double VR_OFFERED_LOAD = 0.7;             // Offered load of every replication
+const unsigned VR_SEED = 9001;                  // First random stream
+
+// Adaptive replication constants
+const double ADAPTIVE_TARGET_WIDTH = 0.05;      // Default target half-width relative to the mean
+const int ADAPTIVE_MIN_REPLICATIONS = 10;       // Replications in the first round
+const int ADAPTIVE_MAX_REPLICATIONS = 5000;     // Hard stop for the sequential procedure
+const int ADAPTIVE_MAX_THREADS = 8;             // Worker threads running replications
+const int ADAPTIVE_PROCESS_COUNT = 200;         // Processes per terminating replication
+const double ADAPTIVE_OFFERED_LOAD = 0.7;       // Offered load of every run
+const unsigned ADAPTIVE_SEED = 4711;            // First random stream
+const long BATCH_INITIAL_PROCESSES = 20000;     // Length of the first steady-state run
+const long BATCH_MAX_PROCESSES = 1280000;       // Longest steady-state run
+const double BATCH_WARMUP_FRACTION = 0.1;       // Share of a run discarded as warm-up
+const int BATCH_MAX_BATCHES = 64;               // Batches before merging
+const int BATCH_MIN_BATCHES = 16;               // Never merge below this many batches
+const double BATCH_MAX_LAG1 = 0.2;              // Batch means with more autocorrelation are merged
+
+// Significance testing constants
+const int STAT_REPLICATIONS = 30;               // Paired replications per policy
+const long STAT_RESAMPLES = 20000;              // Bootstrap resamples and permutations per comparison
+const long STAT_CHUNK = 1024;                   // Resamples per independently seeded chunk
+const int STAT_MAX_THREADS = 8;                 // Worker threads drawing resamples
+const int STAT_PROCESS_COUNT = 200;             // Processes per replication
+const double STAT_OFFERED_LOAD = 0.7;           // Offered load of every replication
+const unsigned STAT_WORKLOAD_SEED = 2718;       // First workload stream
+const uint64_t STAT_SEED = 0x5eed5eedULL;       // Base seed of the resampling streams
+
+// Policy plugin constants
+const int PLUGIN_PROCESS_COUNT = 20000;         // Arrivals in the plugin comparison workload
+const double PLUGIN_OFFERED_LOAD = 0.85;        // Offered load of that workload
+const unsigned PLUGIN_SEED = 1618;              // Workload seed
+
+// Policy DSL constants
+const int DSL_MAX_REGISTERS = 16;               // Registers available to one expression
+const int DSL_BATCH = 64;                       // Processes evaluated per bytecode pass
+const double DSL_PREEMPT_CHECK = 1.0;           // Interval between preemption-condition checks
+const char* const DSL_DEFAULT_KEY = "-priority + age/10 - remaining/4";
+const char* const DSL_DEFAULT_PREEMPT = "run >= 4 && remaining > 1";
+const int DSL_PROCESS_COUNT = 20000;            // Arrivals in the DSL comparison workload
+const double DSL_OFFERED_LOAD = 0.85;           // Offered load of that workload
+const unsigned DSL_SEED = 1414;                 // Workload seed
+
+// Evolutionary policy search constants
+const int GA_POPULATION = 20;                   // Candidate parameter sets per generation
+const int GA_DEFAULT_GENERATIONS = 20;          // Generations per search
+const int GA_ELITES = 2;                        // Best candidates copied unchanged into the next generation
+const int GA_TOURNAMENT = 3;                    // Candidates drawn per parent selection
+const double GA_BLEND_ALPHA = 0.25;             // BLX-alpha crossover widening
+const double GA_MUTATION_RATE = 0.2;            // Chance a gene is mutated
+const double GA_MUTATION_SIGMA = 0.1;           // Mutation step (genes live in [0,1])
+const int GA_TRAINING_WORKLOADS = 2;            // Shared workloads every candidate is scored on
+const int GA_VALIDATION_WORKLOADS = 4;          // Unseen workloads used to check the winner
+const int GA_PROCESS_COUNT = 1500;              // Processes per workload
+const double GA_OFFERED_LOAD = 0.85;            // Offered load of every workload
+const int GA_MAX_THREADS = 8;                   // Worker threads evaluating fitness
+const unsigned GA_SEED = 8128;                  // Seed of workloads and searches
+
+// Pareto front constants
+const int PARETO_OBJECTIVES = 5;                // Mean WT, p99 response, throughput, fairness, switches
+const int PARETO_CONFIGURATIONS = 400;          // MLFQ parameter sets sampled
+const int PARETO_PROCESS_COUNT = 3000;          // Processes in the shared workload
+const double PARETO_OFFERED_LOAD = 0.95;        // Offered load of that workload
+const double PARETO_SWITCH_COST = 0.1;          // CPU time lost per context switch (makes throughput differ)
+const int PARETO_DISPLAY_LIMIT = 20;            // Front members printed
+const int PARETO_MAX_THREADS = 8;               // Worker threads evaluating configurations
+const unsigned PARETO_SEED = 6174;              // Workload and sampling seed
+const char* const PARETO_EXPORT_PATH = "pareto_front.csv";
+
+// Fairness constants
+const int FAIRNESS_SLOWDOWN_BUCKETS = 12;       // Power-of-two slowdown buckets (last is open-ended)
+const int FAIRNESS_PROCESS_COUNT = 20000;       // Default arrivals per policy
+const double FAIRNESS_OFFERED_LOAD = 0.9;       // Offered load of the fairness workload
+const unsigned FAIRNESS_SEED = 1729;            // Workload seed
+
+// Telemetry constants
+const double TELEMETRY_WINDOW = 500;            // Simulated time per sample window
+const double TELEMETRY_PHASE_LOADS[] = {0.6, 1.1, 0.6};   // Offered load of each phase of the run
+const int TELEMETRY_PHASE_PROCESSES = 15000;    // Arrivals per phase
+const size_t TELEMETRY_DISPLAY_ROWS = 24;       // Rows printed (windows are merged to fit)
+const int TELEMETRY_BAR_WIDTH = 20;             // Width of the queue-length bar
+const unsigned TELEMETRY_SEED = 5040;           // Workload seed
+const char* const TELEMETRY_EXPORT_PATH = "telemetry.txt";
+
+// Metrics endpoint constants
+const int PROMETHEUS_DEFAULT_PORT = 9464;       // Port of the local /metrics endpoint
+const int PROMETHEUS_MAX_POLICIES = 32;         // Policies tracked (labels) per process
+const int PROMETHEUS_NAME_LENGTH = 48;          // Longest policy label kept
+const uint64_t PROMETHEUS_FLUSH_EVENTS = 1024;  // Dispatches an engine buffers before publishing
+const double PROMETHEUS_WAIT_BUCKETS[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+const int PROMETHEUS_POLL_MS = 200;             // Server wake-up interval for noticing a stop
+const size_t PROMETHEUS_MAX_REQUEST = 8192;     // Request bytes read before answering
+
 /**
  * Process class representing a process in the scheduling system
- * Contains process ID, burst time, and priority
+ * Contains process ID, burst time, priority and arrival time
  */
 class Process {
 public:
-    int pid;           // Process ID
-    int burst_time;    // CPU burst time required
-    int priority;      // Process priority (lower number = higher priority)
+    int pid;               // Process ID
+    int burst_time;        // CPU burst time required
+    int priority;          // Process priority (lower number = higher priority)
+    double arrival_time;   // Time the process enters the system
 
-    Process(int pid, int burst_time, int priority)
-        : pid(pid), burst_time(burst_time), priority(priority) {}
+    Process(int pid, int burst_time, int priority, double arrival_time = 0)
+        : pid(pid), burst_time(burst_time), priority(priority), arrival_time(arrival_time) {}
 };
 
 /**
@@ -46,6 +325,83 @@ std::vector<Process> generateProcesses(int num_processes) {
     return processes;
 }
 
+/**
+ * Generates a vector of random processes from an explicit seed
+ * Use this when several workloads are built at once: reseeding from time() would repeat them
+ * @param num_processes Number of processes to generate
+ * @param seed Random seed
+ * @return Vector of randomly generated processes
+ */
+std::vector<Process> generateProcesses(int num_processes, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> burst(MIN_BURST_TIME, MAX_BURST_TIME);
+    std::uniform_int_distribution<int> priority(MIN_PRIORITY, MAX_PRIORITY);
+    std::vector<Process> processes;
+
+    for (int i = 0; i < num_processes; i++) {
+        int burst_time = burst(rng);
+        processes.emplace_back(i, burst_time, priority(rng));
+    }
+
+    return processes;
+}
+
+/**
+ * Generates processes arriving as a Poisson process
+ * @param num_processes Number of processes to generate
+ * @param arrival_rate Mean arrivals per time unit
+ * @param seed Random seed (reuse it to replay the same workload)
+ * @return Vector of processes in arrival order
+ */
+std::vector<Process> generateArrivalWorkload(int num_processes, double arrival_rate, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> interarrival(arrival_rate);
+    std::uniform_int_distribution<int> burst(MIN_BURST_TIME, MAX_BURST_TIME);
+    std::uniform_int_distribution<int> priority(MIN_PRIORITY, MAX_PRIORITY);
+    std::vector<Process> processes;
+
+    double time = 0;
+    for (int i = 0; i < num_processes; i++) {
+        time += interarrival(rng);
+        int burst_time = burst(rng);
+        processes.emplace_back(i, burst_time, priority(rng), time);
+    }
+
+    return processes;
+}
+
+/**
+ * Generates a Poisson-arrival workload by inverse-transform sampling, one uniform per draw
+ * The antithetic twin of a seed replays the same uniforms as 1 - U, so long gaps become short
+ * ones and short bursts long ones, giving a negatively correlated replication
+ * @param num_processes Number of processes to generate
+ * @param arrival_rate Mean arrivals per time unit
+ * @param seed Random stream (share it across policies for common random numbers)
+ * @param antithetic Use 1 - U for every draw
+ * @return Vector of processes in arrival order
+ */
+std::vector<Process> generateReplicationWorkload(int num_processes, double arrival_rate, unsigned seed, bool antithetic) {
+    std::mt19937 rng(seed);
+    auto uniform = [&]() {
+        double u = std::generate_canonical<double, 32>(rng);
+        return antithetic ? 1.0 - u : u;
+    };
+    auto uniformInt = [&](int low, int high) {
+        return low + std::min(high - low, static_cast<int>(uniform() * (high - low + 1)));
+    };
+    std::vector<Process> processes;
+
+    double time = 0;
+    for (int i = 0; i < num_processes; i++) {
+        time += -std::log(std::max(1e-300, 1.0 - uniform())) / arrival_rate;
+        int burst_time = uniformInt(MIN_BURST_TIME, MAX_BURST_TIME);
+        int priority = uniformInt(MIN_PRIORITY, MAX_PRIORITY);
+        processes.emplace_back(i, burst_time, priority, time);
+    }
+
+    return processes;
+}
+
 /**
  * Displays all processes in a formatted table
  * @param processes Vector of processes to display
@@ -369,16 +725,18 @@ double round_robin(const std::vector<Process>& processes) {
  * Multilevel Queue Scheduling Algorithm
  * Processes are distributed into different queues and each queue uses a different scheduling algorithm
  * @param processes Vector of processes to schedule
+ * @param seed Seed for the queue assignment (reuse it to compare runs on the same assignment)
  * @return Average waiting time
  */
-double multilevel_queue_scheduling(const std::vector<Process>& processes) {
+double multilevel_queue_scheduling(const std::vector<Process>& processes, unsigned seed = time(nullptr)) {
     int N = processes.size();
     std::vector<std::vector<Process>> queues(NUM_QUEUES); // Create 3 queues
 
-    // Randomly distribute processes into queues
-    srand(time(nullptr)); // Set seed based on system time
+    // Randomly distribute processes into queues with a private generator, leaving rand() untouched
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick_queue(0, NUM_QUEUES - 1);
     for (const auto& process : processes) {
-        int queue_number = rand() % NUM_QUEUES; // Generate random number between 0 and 2
+        int queue_number = pick_queue(rng); // Generate random number between 0 and 2
         queues[queue_number].push_back(process); // Add process to queue
     }
 
@@ -442,66 +800,7488 @@ double multilevel_queue_scheduling(const std::vector<Process>& processes) {
 }
 
 /**
- * Main function - Interactive CPU Scheduling Simulator
- * Provides a menu-driven interface to test different scheduling algorithms
+ * Summary statistics for a set of per-process latencies
+ * Used to report tail behaviour (p95/p99) in addition to averages
  */
-int main() {
-    srand(time(nullptr));
+struct LatencySummary {
+    double mean = 0;
+    double p50 = 0;
+    double p95 = 0;
+    double p99 = 0;
+    double max = 0;
+};
 
-    std::cout << std::string(80, '=') << std::endl;
-    std::cout << "                    CPU SCHEDULING ALGORITHM SIMULATOR" << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
-    std::cout << "This program demonstrates various CPU scheduling algorithms used in operating systems." << std::endl;
-    std::cout << "Processes are generated with random burst times and priorities for testing." << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
+/**
+ * Computes mean and nearest-rank percentiles of a set of latencies
+ * @param values Latency samples (copied and sorted)
+ * @return Summary of the samples
+ */
+LatencySummary summarizeLatencies(std::vector<double> values) {
+    LatencySummary summary;
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (double value : values) {
+        sum += value;
+    }
+    int N = values.size();
+    auto percentile = [&](double p) {
+        int rank = static_cast<int>(std::ceil(p * N)) - 1;
+        return values[std::max(0, std::min(N - 1, rank))];
+    };
+    summary.mean = sum / N;
+    summary.p50 = percentile(0.50);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    summary.max = values.back();
+    return summary;
+}
 
-    std::vector<Process> processes = generateProcesses(DEFAULT_PROCESS_COUNT);
-    std::cout << "\nGenerated " << DEFAULT_PROCESS_COUNT << " random processes for testing." << std::endl;
+/**
+ * Mean of independent replications with a 95% confidence interval
+ */
+struct ConfidenceInterval {
+    double mean = 0;
+    double half_width = 0;
+    double variance = 0;   // Sample variance of one replication
+    int samples = 0;
+};
 
-    while(true) {
-        int choice;
-        do {
-            std::cout << "\n" << std::string(60, '=') << std::endl;
-            std::cout << "                    SCHEDULING ALGORITHMS MENU" << std::endl;
-            std::cout << std::string(60, '=') << std::endl;
-            std::cout << "1. First Come First Served (FCFS)" << std::endl;
-            std::cout << "2. Shortest Job First (SJF)" << std::endl;
-            std::cout << "3. Priority Scheduling" << std::endl;
-            std::cout << "4. Round Robin (RR)" << std::endl;
-            std::cout << "5. Multilevel Queue Scheduling" << std::endl;
-            std::cout << std::string(60, '-') << std::endl;
-            std::cout << "8. Display Current Processes" << std::endl;
-            std::cout << "9. Generate New Processes" << std::endl;
-            std::cout << "0. Exit Program" << std::endl;
-            std::cout << std::string(60, '=') << std::endl;
-            std::cout << "Enter your choice (0-9): ";
-            std::cin >> choice;
+/**
+ * Two-sided 95% Student t critical value (Cornish-Fisher expansion around the normal quantile)
+ * @param df Degrees of freedom
+ */
+double studentTCritical(int df) {
+    const double z = 1.959964;
+    if (df < 1) return std::numeric_limits<double>::infinity();
+    double n = df;
+    return z + (z * z * z + z) / (4 * n) + (5 * std::pow(z, 5) + 16 * z * z * z + 3 * z) / (96 * n * n)
+             + (3 * std::pow(z, 7) + 19 * std::pow(z, 5) + 17 * z * z * z - 15 * z) / (384 * n * n * n);
+}
 
-            // Input validation
-            if (std::cin.fail() || choice == 6 || choice == 7 || choice < 0 || choice > 9) {
-                std::cout << "\nInvalid option! Please enter a valid choice (0-9)." << std::endl;
-                std::cin.clear();
-                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/**
+ * 95% confidence interval for the mean of independent samples
+ * @param values One value per replication
+ * @param lost_df Degrees of freedom used up by fitted parameters (e.g. control-variate coefficients)
+ */
+ConfidenceInterval confidenceInterval(const std::vector<double>& values, int lost_df = 0) {
+    ConfidenceInterval ci;
+    ci.samples = values.size();
+    if (ci.samples == 0) return ci;
+    for (double value : values) ci.mean += value / ci.samples;
+    if (ci.samples < 2) {
+        ci.half_width = std::numeric_limits<double>::infinity();
+        return ci;
+    }
+    for (double value : values) ci.variance += (value - ci.mean) * (value - ci.mean);
+    ci.variance /= ci.samples - 1;
+    ci.half_width = studentTCritical(ci.samples - 1 - lost_df) * std::sqrt(ci.variance / ci.samples);
+    return ci;
+}
+
+/**
+ * Logical CPU (hardware thread) in the simulated machine
+ * Siblings share a core; cores share a socket and its last-level cache
+ */
+struct LogicalCpu {
+    int id;        // Logical CPU number
+    int core;      // Physical core (global numbering)
+    int socket;    // Socket / package
+    int node;      // NUMA node whose memory controller is local
+};
+
+/**
+ * Simulated machine: its shape plus the expanded list of logical CPUs
+ */
+struct MachineTopology {
+    int sockets = NUM_SOCKETS;
+    int nodes_per_socket = 1;
+    int cores_per_socket = CORES_PER_SOCKET;
+    int threads_per_core = THREADS_PER_CORE;
+    double remote_memory_penalty = REMOTE_MEMORY_PENALTY;
+    std::vector<LogicalCpu> cpus;
+};
+
+/**
+ * Builds a symmetric machine topology
+ * Cores of a socket are split evenly between its NUMA nodes
+ * @param sockets Number of sockets
+ * @param cores_per_socket Physical cores in each socket
+ * @param threads_per_core SMT threads in each core
+ * @param nodes_per_socket NUMA nodes in each socket
+ * @return Topology with logical CPUs numbered socket-major
+ */
+MachineTopology buildTopology(int sockets, int cores_per_socket, int threads_per_core, int nodes_per_socket = 1) {
+    MachineTopology topology;
+    topology.sockets = sockets;
+    topology.nodes_per_socket = nodes_per_socket;
+    topology.cores_per_socket = cores_per_socket;
+    topology.threads_per_core = threads_per_core;
+    for (int s = 0; s < sockets; s++) {
+        for (int c = 0; c < cores_per_socket; c++) {
+            int node = s * nodes_per_socket + c * nodes_per_socket / cores_per_socket;
+            for (int t = 0; t < threads_per_core; t++) {
+                topology.cpus.push_back({static_cast<int>(topology.cpus.size()), s * cores_per_socket + c, s, node});
             }
+        }
+    }
+    return topology;
+}
 
-        } while (std::cin.fail() || choice == 6 || choice == 7 || choice < 0 || choice > 9);
+/**
+ * Loads a machine description from a topology file
+ * The file holds "key value" lines (sockets, nodes_per_socket, cores_per_socket,
+ * threads_per_core, remote_memory_penalty); '#' starts a comment
+ * @param path Path of the topology file
+ * @param topology Receives the loaded topology on success
+ * @return true if the file was read and describes a valid machine
+ */
+bool loadTopologyFile(const std::string& path, MachineTopology& topology) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cout << "Could not open topology file: " << path << std::endl;
+        return false;
+    }
 
-        switch (choice) {
-            case 1:
-                first_come_first_served(processes);
-                break;
-            case 2:
-                shortest_job_first(processes);
-                break;
-            case 3:
-                priority_scheduling(processes);
-                break;
-            case 4:
-                round_robin(processes);
-                break;
-            case 5:
-                multilevel_queue_scheduling(processes);
-                break;
+    MachineTopology loaded;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) continue;
+
+        std::string value, extra;
+        if (!(fields >> value)) {
+            std::cout << path << ":" << line_number << ": missing value for '" << key << "'" << std::endl;
+            return false;
+        }
+        if (fields >> extra) {
+            std::cout << path << ":" << line_number << ": unexpected '" << extra << "' after value" << std::endl;
+            return false;
+        }
+
+        // Counts must be whole numbers in [1, TOPOLOGY_MAX_COUNT]; the whole token has to parse
+        auto count = [&](int& target) {
+            size_t used = 0;
+            long parsed = 0;
+            try {
+                parsed = std::stol(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used != value.size() || parsed < 1 || parsed > TOPOLOGY_MAX_COUNT) {
+                std::cout << path << ":" << line_number << ": '" << key << "' must be an integer from 1 to "
+                          << TOPOLOGY_MAX_COUNT << ", got '" << value << "'" << std::endl;
+                return false;
+            }
+            target = static_cast<int>(parsed);
+            return true;
+        };
+        if (key == "sockets") {
+            if (!count(loaded.sockets)) return false;
+        } else if (key == "nodes_per_socket") {
+            if (!count(loaded.nodes_per_socket)) return false;
+        } else if (key == "cores_per_socket") {
+            if (!count(loaded.cores_per_socket)) return false;
+        } else if (key == "threads_per_core") {
+            if (!count(loaded.threads_per_core)) return false;
+        } else if (key == "remote_memory_penalty") {
+            size_t used = 0;
+            try {
+                loaded.remote_memory_penalty = std::stod(value, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used != value.size()) {
+                std::cout << path << ":" << line_number << ": invalid number '" << value << "'" << std::endl;
+                return false;
+            }
+        } else {
+            std::cout << path << ":" << line_number << ": unknown key '" << key << "'" << std::endl;
+            return false;
+        }
+    }
+
+    long cpus = static_cast<long>(loaded.sockets) * loaded.cores_per_socket * loaded.threads_per_core;
+    if (cpus > TOPOLOGY_MAX_CPUS) {
+        std::cout << path << ": " << cpus << " logical CPUs exceeds the limit of " << TOPOLOGY_MAX_CPUS << std::endl;
+        return false;
+    }
+
+    if (loaded.sockets < 1 || loaded.nodes_per_socket < 1 || loaded.cores_per_socket < 1 ||
+        loaded.threads_per_core < 1 || loaded.cores_per_socket % loaded.nodes_per_socket != 0 ||
+        loaded.remote_memory_penalty < 0 || loaded.remote_memory_penalty >= 1) {
+        std::cout << path << ": invalid topology (cores_per_socket must divide evenly into nodes)" << std::endl;
+        return false;
+    }
+
+    double penalty = loaded.remote_memory_penalty;
+    topology = buildTopology(loaded.sockets, loaded.cores_per_socket, loaded.threads_per_core, loaded.nodes_per_socket);
+    topology.remote_memory_penalty = penalty;
+    return true;
+}
+
+/**
+ * Topology distance between two logical CPUs
+ * @return DISTANCE_SAME_CPU, DISTANCE_SAME_CORE, DISTANCE_SAME_SOCKET or DISTANCE_CROSS_SOCKET
+ */
+int topologyDistance(const LogicalCpu& a, const LogicalCpu& b) {
+    if (a.id == b.id) return DISTANCE_SAME_CPU;
+    if (a.core == b.core) return DISTANCE_SAME_CORE;
+    if (a.socket == b.socket) return DISTANCE_SAME_SOCKET;
+    return DISTANCE_CROSS_SOCKET;
+}
+
+/**
+ * Load balancing strategies used when a CPU runs out of work
+ */
+enum BalancePolicy {
+    BALANCE_NONE,       // No migration: each CPU only runs what it was given
+    BALANCE_GREEDY,     // Steal from the busiest CPU anywhere, ignoring topology
+    BALANCE_AFFINITY,   // Steal from the nearest CPU first, preferring cache-cold tasks
+    BALANCE_NUMA        // Affinity-aware within a node; pulls processes home and migrates memory
+};
+
+const char* balancePolicyName(BalancePolicy policy) {
+    switch (policy) {
+        case BALANCE_NONE: return "No Balancing";
+        case BALANCE_GREEDY: return "Greedy Balancing";
+        case BALANCE_AFFINITY: return "Affinity-Aware Balancing";
+        case BALANCE_NUMA: return "NUMA-Aware Balancing";
+    }
+    return "Unknown";
+}
+
+/**
+ * A device raising interrupts on the multi-core machine
+ * Each interrupt runs a hard handler immediately and queues softirq work on the same CPU
+ */
+struct InterruptSource {
+    std::string name;
+    double rate;                 // Mean interrupts per tick (Poisson arrivals)
+    double handler_cost;         // Hard IRQ handler time per interrupt
+    double softirq_cost;         // Bottom-half work queued per interrupt
+    std::vector<int> affinity;   // CPUs allowed to take the interrupt, rotated round robin
+};
+
+/**
+ * Results of a multi-core simulation run
+ */
+struct MultiCoreResult {
+    std::vector<double> waiting_time;
+    std::vector<double> turnaround_time;
+    int migrations[DISTANCE_CROSS_SOCKET + 1] = {0, 0, 0, 0};   // Indexed by topology distance
+    long smt_contended_ticks = 0;                             // Ticks run with a busy sibling
+    long remote_memory_ticks = 0;                             // Ticks run away from the home node
+    int page_migrations = 0;                                  // Home node changes by NUMA balancing
+    std::vector<double> irq_time;                             // Per-CPU time taken by interrupts and softirqs
+    long interrupts = 0;                                      // Hard interrupts delivered
+    double softirq_deferred = 0;                              // Softirq work handed to ksoftirqd
+    double softirq_backlog = 0;                               // Softirq work still unserved at the end
+    int makespan = 0;
+};
+
+/**
+ * Simulates Round Robin on every logical CPU of a multi-core machine
+ * Models SMT sibling contention, per-process LLC warmth, topology-dependent migration costs
+ * and a memory-locality penalty for processes running away from their home NUMA node.
+ * Interrupts steal time from whatever runs on the CPU they are delivered to; softirq work
+ * beyond the inline budget is deferred to ksoftirqd, which shares a busy CPU with the process
+ * @param processes Vector of processes to schedule (all arrive at time 0)
+ * @param topology Machine topology
+ * @param policy Load balancing strategy for idle CPUs
+ * @param interrupts Interrupt sources with their CPU affinity (none by default)
+ * @param seed Seed for interrupt arrivals
+ * @return Per-process times and migration statistics
+ */
+MultiCoreResult simulate_multi_core(const std::vector<Process>& processes,
+                                    const MachineTopology& topology,
+                                    BalancePolicy policy,
+                                    const std::vector<InterruptSource>& interrupts = std::vector<InterruptSource>(),
+                                    unsigned seed = IRQ_SEED) {
+    const std::vector<LogicalCpu>& cpus = topology.cpus;
+    int N = processes.size();
+    int C = cpus.size();
+    MultiCoreResult result;
+    result.waiting_time.assign(N, 0);
+    result.turnaround_time.assign(N, 0);
+    result.irq_time.assign(C, 0);
+
+    std::mt19937 rng(seed);
+    std::vector<std::poisson_distribution<int>> irq_arrivals;
+    for (const InterruptSource& source : interrupts) {
+        irq_arrivals.emplace_back(source.rate);
+    }
+    std::vector<size_t> irq_next(interrupts.size(), 0);   // Round-robin position in each affinity mask
+    std::vector<double> softirq_pending(C, 0);            // Bottom-half work waiting on each CPU
+
+    std::vector<double> remaining(N);
+    std::vector<double> warmth(N, 0);      // LLC warmth in [0, 1]
+    std::vector<int> last_cpu(N, -1);
+    std::vector<int> home_node(N, 0);      // NUMA node holding the process's memory
+    std::vector<int> remote_streak(N, 0);  // Consecutive ticks run away from home
+    for (int i = 0; i < N; i++) {
+        remaining[i] = processes[i].burst_time;
+    }
+
+    std::vector<std::deque<int>> run_queue(C);
+    std::vector<int> running(C, -1);
+    std::vector<int> slice_left(C, 0);
+    std::vector<int> stall(C, 0);          // Ticks left paying a migration penalty
+
+    // Initial placement: least-loaded CPU, spreading across cores before filling siblings
+    for (int i = 0; i < N; i++) {
+        auto core_load = [&](int cpu) {
+            size_t load = 0;
+            for (int c = 0; c < C; c++) {
+                if (cpus[c].core == cpus[cpu].core) load += run_queue[c].size();
+            }
+            return load;
+        };
+        int best = 0;
+        for (int c = 1; c < C; c++) {
+            if (run_queue[c].size() < run_queue[best].size() ||
+                (run_queue[c].size() == run_queue[best].size() && core_load(c) < core_load(best))) {
+                best = c;
+            }
+        }
+        run_queue[best].push_back(i);
+    }
+
+    auto steal = [&](int thief) {
+        int victim = -1;
+        if (policy == BALANCE_GREEDY) {
+            for (int c = 0; c < C; c++) {
+                if (!run_queue[c].empty() && (victim == -1 || run_queue[c].size() > run_queue[victim].size())) {
+                    victim = c;
+                }
+            }
+            if (victim != -1) {
+                run_queue[thief].push_back(run_queue[victim].front());
+                run_queue[victim].pop_front();
+            }
+        } else if (policy == BALANCE_AFFINITY) {
+            // Search scheduling domains from the nearest outward
+            for (int d = DISTANCE_SAME_CORE; d <= DISTANCE_CROSS_SOCKET && victim == -1; d++) {
+                size_t min_load = (d == DISTANCE_CROSS_SOCKET) ? CROSS_SOCKET_IMBALANCE : 1;
+                for (int c = 0; c < C; c++) {
+                    if (topologyDistance(cpus[thief], cpus[c]) == d && run_queue[c].size() >= min_load &&
+                        (victim == -1 || run_queue[c].size() > run_queue[victim].size())) {
+                        victim = c;
+                    }
+                }
+            }
+            if (victim != -1) {
+                // Prefer the task with the least cache warmth to lose
+                auto coldest = std::min_element(run_queue[victim].begin(), run_queue[victim].end(),
+                    [&](int a, int b) { return warmth[a] < warmth[b]; });
+                run_queue[thief].push_back(*coldest);
+                run_queue[victim].erase(coldest);
+            }
+        } else if (policy == BALANCE_NUMA) {
+            // Domains: SMT siblings, same node, same socket (other node), other sockets
+            auto domain = [&](int c) {
+                if (cpus[c].core == cpus[thief].core) return 0;
+                if (cpus[c].node == cpus[thief].node) return 1;
+                if (cpus[c].socket == cpus[thief].socket) return 2;
+                return 3;
+            };
+            for (int d = 0; d <= 3 && victim == -1; d++) {
+                size_t min_load = d == 3 ? CROSS_SOCKET_IMBALANCE : d == 2 ? CROSS_NODE_IMBALANCE : 1;
+                for (int c = 0; c < C; c++) {
+                    if (c != thief && domain(c) == d && run_queue[c].size() >= min_load &&
+                        (victim == -1 || run_queue[c].size() > run_queue[victim].size())) {
+                        victim = c;
+                    }
+                }
+            }
+            if (victim != -1) {
+                // Pull a process whose memory lives on this node, otherwise the coldest one
+                auto pick = std::find_if(run_queue[victim].begin(), run_queue[victim].end(),
+                    [&](int p) { return home_node[p] == cpus[thief].node; });
+                if (pick == run_queue[victim].end()) {
+                    pick = std::min_element(run_queue[victim].begin(), run_queue[victim].end(),
+                        [&](int a, int b) { return warmth[a] < warmth[b]; });
+                }
+                run_queue[thief].push_back(*pick);
+                run_queue[victim].erase(pick);
+            }
+        }
+    };
+
+    int time = 0;
+    int completed = 0;
+    while (completed < N) {
+        // Dispatch work onto idle CPUs; CPUs whose own queue is empty steal afterwards
+        std::vector<int> idle;
+        for (int c = 0; c < C; c++) {
+            if (running[c] == -1) idle.push_back(c);
+        }
+        std::stable_partition(idle.begin(), idle.end(), [&](int c) { return !run_queue[c].empty(); });
+        for (int c : idle) {
+            if (run_queue[c].empty()) steal(c);
+            if (run_queue[c].empty()) continue;
+
+            int p = run_queue[c].front();
+            run_queue[c].pop_front();
+            if (last_cpu[p] == -1) {
+                home_node[p] = cpus[c].node;   // First touch allocates memory locally
+            } else if (last_cpu[p] != c) {
+                int d = topologyDistance(cpus[last_cpu[p]], cpus[c]);
+                result.migrations[d]++;
+                if (d == DISTANCE_CROSS_SOCKET) {
+                    stall[c] = MIGRATION_COST_CROSS_SOCKET;
+                    warmth[p] = 0;
+                } else if (d == DISTANCE_SAME_SOCKET) {
+                    stall[c] = MIGRATION_COST_SAME_SOCKET;
+                    warmth[p] *= SAME_SOCKET_WARMTH_KEPT;
+                }
+            }
+            running[c] = p;
+            last_cpu[p] = c;
+            slice_left[c] = QUANTUM;
+        }
+
+        // Deliver interrupts and run softirqs; whatever they take is lost to the running process
+        std::vector<double> stolen(C, 0);
+        for (size_t s = 0; s < interrupts.size(); s++) {
+            const std::vector<int>& mask = interrupts[s].affinity;
+            if (mask.empty()) continue;
+            for (int k = irq_arrivals[s](rng); k > 0; k--) {
+                int c = mask[irq_next[s]++ % mask.size()];
+                stolen[c] += interrupts[s].handler_cost;
+                softirq_pending[c] += interrupts[s].softirq_cost;
+                result.interrupts++;
+            }
+        }
+        for (int c = 0; c < C; c++) {
+            double inline_work = std::min(softirq_pending[c], SOFTIRQ_INLINE_BUDGET);
+            stolen[c] += inline_work;
+            softirq_pending[c] -= inline_work;
+            if (softirq_pending[c] > 0 && stolen[c] < 1.0) {
+                // ksoftirqd takes an idle CPU outright but only its share of a busy one
+                double room = 1.0 - stolen[c];
+                if (running[c] != -1) room *= KSOFTIRQD_SHARE;
+                double deferred = std::min(softirq_pending[c], room);
+                stolen[c] += deferred;
+                softirq_pending[c] -= deferred;
+                result.softirq_deferred += deferred;
+            }
+            stolen[c] = std::min(stolen[c], 1.0);
+            result.irq_time[c] += stolen[c];
+        }
+
+        // Execute one tick on every busy CPU
+        std::vector<bool> busy(C);
+        for (int c = 0; c < C; c++) {
+            busy[c] = running[c] != -1;
+        }
+        for (int c = 0; c < C; c++) {
+            int p = running[c];
+            if (p == -1) continue;
+            if (stall[c] > 0) {
+                stall[c]--;
+                continue;
+            }
+            double rate = 1.0 - COLD_CACHE_SLOWDOWN * (1.0 - warmth[p]);
+            if (cpus[c].node != home_node[p]) {
+                rate *= 1.0 - topology.remote_memory_penalty;
+                result.remote_memory_ticks++;
+                if (policy == BALANCE_NUMA && ++remote_streak[p] >= NUMA_MIGRATE_AFTER) {
+                    // Automatic NUMA balancing moves the memory next to the CPU
+                    home_node[p] = cpus[c].node;
+                    remote_streak[p] = 0;
+                    stall[c] = NUMA_PAGE_MIGRATION_COST;
+                    result.page_migrations++;
+                }
+            } else {
+                remote_streak[p] = 0;
+            }
+            for (int s = 0; s < C; s++) {
+                if (s != c && cpus[s].core == cpus[c].core && busy[s]) {
+                    rate *= 1.0 - SMT_SIBLING_SLOWDOWN;
+                    result.smt_contended_ticks++;
+                    break;
+                }
+            }
+            rate *= 1.0 - stolen[c];
+            remaining[p] -= rate;
+            warmth[p] = std::min(1.0, warmth[p] + CACHE_WARMUP_RATE);
+            slice_left[c]--;
+        }
+
+        // Caches of waiting processes cool down
+        for (int i = 0; i < N; i++) {
+            bool on_cpu = last_cpu[i] != -1 && running[last_cpu[i]] == i;
+            if (!on_cpu && remaining[i] > 0) {
+                warmth[i] *= 1.0 - CACHE_WARMTH_DECAY;
+            }
+        }
+        time++;
+
+        // Handle completions and quantum expiry
+        for (int c = 0; c < C; c++) {
+            int p = running[c];
+            if (p == -1) continue;
+            if (remaining[p] <= 1e-9) {
+                remaining[p] = 0;
+                result.turnaround_time[p] = time;
+                result.waiting_time[p] = time - processes[p].burst_time;
+                running[c] = -1;
+                completed++;
+            } else if (slice_left[c] <= 0) {
+                if (run_queue[c].empty()) {
+                    slice_left[c] = QUANTUM;
+                } else {
+                    run_queue[c].push_back(p);
+                    running[c] = -1;
+                }
+            }
+        }
+    }
+
+    for (int c = 0; c < C; c++) {
+        result.softirq_backlog += softirq_pending[c];
+    }
+    result.makespan = time;
+    return result;
+}
+
+/**
+ * Multi-Core Scheduling Simulation
+ * Runs Round Robin on every logical CPU and compares load balancing strategies
+ * @param processes Vector of processes to schedule
+ * @param topology Machine to simulate
+ * @return Average waiting time under NUMA-aware balancing
+ */
+double multi_core_scheduling(const std::vector<Process>& processes, const MachineTopology& topology) {
+    const std::vector<LogicalCpu>& cpus = topology.cpus;
+
+    std::cout << "\n" << std::string(70, '=') << std::endl;
+    std::cout << "MULTI-CORE SCHEDULING (Round Robin per CPU, Quantum = " << QUANTUM << ")" << std::endl;
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "Topology: " << topology.sockets << " sockets x " << topology.cores_per_socket << " cores x "
+              << topology.threads_per_core << " threads = " << cpus.size() << " logical CPUs, "
+              << topology.sockets * topology.nodes_per_socket << " NUMA nodes" << std::endl;
+    std::cout << "Processes: " << processes.size() << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << std::setw(26) << std::left << "Policy" << std::right
+              << std::setw(9) << "Avg WT" << std::setw(9) << "Avg TAT"
+              << std::setw(8) << "p95" << std::setw(8) << "p99"
+              << std::setw(10) << "Makespan" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    double numa_waiting_time = 0;
+    std::vector<MultiCoreResult> results;
+    const BalancePolicy policies[] = {BALANCE_NONE, BALANCE_GREEDY, BALANCE_AFFINITY, BALANCE_NUMA};
+    for (BalancePolicy policy : policies) {
+        MultiCoreResult result = simulate_multi_core(processes, topology, policy);
+        LatencySummary wait = summarizeLatencies(result.waiting_time);
+        LatencySummary turnaround = summarizeLatencies(result.turnaround_time);
+        std::cout << std::setw(26) << std::left << balancePolicyName(policy) << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(9) << wait.mean << std::setw(9) << turnaround.mean
+                  << std::setw(8) << turnaround.p95 << std::setw(8) << turnaround.p99
+                  << std::setw(10) << result.makespan << std::endl;
+        if (policy == BALANCE_NUMA) {
+            numa_waiting_time = wait.mean;
+        }
+        results.push_back(result);
+    }
+
+    std::cout << "\n" << std::string(70, '-') << std::endl;
+    std::cout << std::setw(26) << std::left << "Policy" << std::right
+              << std::setw(11) << "SMT Ticks" << std::setw(11) << "Same Core"
+              << std::setw(12) << "Same Socket" << std::setw(7) << "Cross"
+              << std::setw(9) << "Remote" << std::setw(7) << "Pages" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        std::cout << std::setw(26) << std::left << balancePolicyName(policies[i]) << std::right
+                  << std::setw(11) << results[i].smt_contended_ticks
+                  << std::setw(11) << results[i].migrations[DISTANCE_SAME_CORE]
+                  << std::setw(12) << results[i].migrations[DISTANCE_SAME_SOCKET]
+                  << std::setw(7) << results[i].migrations[DISTANCE_CROSS_SOCKET]
+                  << std::setw(9) << results[i].remote_memory_ticks
+                  << std::setw(7) << results[i].page_migrations << std::endl;
+    }
+    std::cout << std::string(70, '=') << std::endl;
+
+    return numa_waiting_time;
+}
+
+/**
+ * Interrupt Load Simulation
+ * Runs NUMA-aware multi-core scheduling under a network-heavy interrupt load
+ * and compares IRQ affinity settings against an interrupt-free baseline
+ * @param processes Vector of processes to schedule
+ * @param topology Machine to simulate
+ * @return Logical CPUs left for processes under the best affinity setting
+ */
+double interrupt_load_simulation(const std::vector<Process>& processes, const MachineTopology& topology) {
+    const std::vector<LogicalCpu>& cpus = topology.cpus;
+    int C = cpus.size();
+
+    std::vector<int> all_cpus, cpu0, housekeeping, rx_queues;
+    for (int c = 0; c < C; c++) {
+        all_cpus.push_back(c);
+        if (cpus[c].core == cpus[0].core) housekeeping.push_back(c);
+        if (cpus[c].socket == cpus[0].socket && topologyDistance(cpus[c], cpus[0]) != DISTANCE_SAME_CORE) {
+            // One receive queue per physical core on the NIC's socket (RSS)
+            bool first_thread = true;
+            for (int q : rx_queues) {
+                if (cpus[q].core == cpus[c].core) first_thread = false;
+            }
+            if (first_thread) rx_queues.push_back(c);
+        }
+    }
+    cpu0.push_back(0);
+
+    // Sources: name, mean interrupts per tick, hard IRQ cost, softirq cost
+    std::vector<InterruptSource> sources = {
+        {"nic-rx", 10.0, 0.02, 0.12, {}},
+        {"nic-tx", 2.0, 0.01, 0.04, {}},
+        {"nvme", 0.5, 0.03, 0.05, {}},
+    };
+    double offered = 0;
+    for (const InterruptSource& source : sources) {
+        offered += source.rate * (source.handler_cost + source.softirq_cost);
+    }
+
+    struct AffinitySetting {
+        const char* name;
+        bool enabled;
+        std::vector<int> rx, other;
+    };
+    const AffinitySetting settings[] = {
+        {"No Interrupts", false, {}, {}},
+        {"All on CPU 0", true, cpu0, cpu0},
+        {"Housekeeping Core", true, housekeeping, housekeeping},
+        {"Spread (irqbalance)", true, all_cpus, all_cpus},
+        {"RSS Queues + Spread", true, rx_queues, all_cpus},
+    };
+
+    std::cout << "\n" << std::string(86, '=') << std::endl;
+    std::cout << "INTERRUPT AND SOFTIRQ LOAD (" << balancePolicyName(BALANCE_NUMA) << ", Quantum = " << QUANTUM << ")" << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << "Topology: " << C << " logical CPUs, " << processes.size() << " processes" << std::endl;
+    std::cout << "Interrupt sources:";
+    for (const InterruptSource& source : sources) {
+        std::cout << " " << source.name << " (" << source.rate << "/tick)";
+    }
+    std::cout << std::fixed << std::setprecision(2) << ", offered " << offered << " CPUs" << std::endl;
+    std::cout << "Softirq inline budget " << SOFTIRQ_INLINE_BUDGET << " per tick, ksoftirqd share "
+              << KSOFTIRQD_SHARE << " of a busy CPU" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    std::cout << std::setw(22) << std::left << "IRQ Affinity" << std::right
+              << std::setw(8) << "Avg WT" << std::setw(8) << "p99 TAT" << std::setw(10) << "Makespan"
+              << std::setw(8) << "IRQ %" << std::setw(10) << "Max CPU%" << std::setw(10) << "Deferred" << std::setw(9) << "Backlog"
+              << std::setw(8) << "Avail" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+
+    double best_available = 0;
+    for (const AffinitySetting& setting : settings) {
+        std::vector<InterruptSource> active;
+        if (setting.enabled) {
+            for (InterruptSource source : sources) {
+                source.affinity = source.name == "nic-rx" ? setting.rx : setting.other;
+                active.push_back(source);
+            }
+        }
+        MultiCoreResult result = simulate_multi_core(processes, topology, BALANCE_NUMA, active);
+        LatencySummary wait = summarizeLatencies(result.waiting_time);
+        LatencySummary turnaround = summarizeLatencies(result.turnaround_time);
+
+        double total_irq = 0, max_irq = 0;
+        for (double t : result.irq_time) {
+            total_irq += t;
+            max_irq = std::max(max_irq, t);
+        }
+        double available = C - total_irq / result.makespan;
+        std::cout << std::setw(22) << std::left << setting.name << std::right
+                  << std::setw(8) << wait.mean << std::setw(8) << turnaround.p99
+                  << std::setw(10) << result.makespan
+                  << std::setw(7) << 100.0 * total_irq / (C * result.makespan) << "%"
+                  << std::setw(9) << 100.0 * max_irq / result.makespan << "%"
+                  << std::setw(10) << result.softirq_deferred << std::setw(9) << result.softirq_backlog
+                  << std::setw(8) << available << std::endl;
+        if (setting.enabled) {
+            best_available = std::max(best_available, available);
+        }
+    }
+    std::cout << std::string(86, '-') << std::endl;
+    std::cout << "IRQ %: share of all CPU time spent in hard IRQ and softirq context" << std::endl;
+    std::cout << "Max CPU%: the most interrupt-loaded CPU; Backlog: softirq work never served (dropped packets)" << std::endl;
+    std::cout << "Avail: logical CPUs left for processes" << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+
+    return best_available;
+}
+
+/**
+ * Snapshot of a ready process handed to a scheduling policy
+ */
+struct ReadyProcess {
+    int index;             // Position of the process in the workload vector
+    int pid;               // Process ID
+    int priority;          // Process priority (lower number = higher priority)
+    int burst_time;        // Total CPU burst time required
+    double arrival_time;   // Time the process entered the system
+    double remaining;      // CPU time still required
+};
+
+/**
+ * Interface implemented by every policy that runs on the simulation engine
+ * The engine owns time and process state; a policy only decides what runs next
+ */
+class SchedulerPolicy {
+public:
+    virtual ~SchedulerPolicy() {}
+
+    // Display name of the policy
+    virtual std::string name() const = 0;
+
+    // A process became ready (arrival or preemption)
+    virtual void enqueue(const ReadyProcess& process, double now) = 0;
+
+    // Removes and returns the index of the next process to run, or -1 if none may run now
+    virtual int pickNext(double now) = 0;
+
+    // True when no process is queued
+    virtual bool empty() const = 0;
+
+    // Maximum time the picked process may run before preemption (0 = until completion)
+    virtual double timeSlice(int index, double now) { (void)index; (void)now; return 0; }
+
+    // The process ran for 'ran' time units ending at 'now'
+    virtual void onTick(int index, double ran, double now) { (void)index; (void)ran; (void)now; }
+
+    // The process finished at 'now'
+    virtual void onComplete(int index, double now) { (void)index; (void)now; }
+
+    // Earliest time a queued but currently ineligible process may run (e.g. throttled groups)
+    virtual double nextEligibleTime(double now) const { return now; }
+
+    // True once the policy broke its contract (e.g. a faulty plugin); the engine stops the run
+    virtual bool failed() const { return false; }
+};
+
+/**
+ * Classic single-queue policies available on the engine
+ */
+enum PolicyKind {
+    POLICY_FCFS,
+    POLICY_SJF,
+    POLICY_PRIORITY,
+    POLICY_RR
+};
+
+const char* policyKindName(PolicyKind kind) {
+    switch (kind) {
+        case POLICY_FCFS: return "FCFS";
+        case POLICY_SJF: return "SJF";
+        case POLICY_PRIORITY: return "Priority";
+        case POLICY_RR: return "Round Robin";
+    }
+    return "Unknown";
+}
+
+/**
+ * FCFS, SJF, Priority and Round Robin as a single keyed ready queue
+ * Ties are broken by enqueue order, so FCFS and RR are plain FIFOs
+ */
+class QueuePolicy : public SchedulerPolicy {
+public:
+    explicit QueuePolicy(PolicyKind kind, double quantum = QUANTUM) : kind(kind), quantum(quantum) {}
+
+    std::string name() const override { return policyKindName(kind); }
+
+    void enqueue(const ReadyProcess& process, double now) override {
+        (void)now;
+        double key = 0;
+        if (kind == POLICY_SJF) key = process.burst_time;
+        else if (kind == POLICY_PRIORITY) key = process.priority;
+        queue.push(Entry{key, sequence++, process.index});
+    }
+
+    int pickNext(double now) override {
+        (void)now;
+        if (queue.empty()) return -1;
+        int index = queue.top().index;
+        queue.pop();
+        return index;
+    }
+
+    bool empty() const override { return queue.empty(); }
+
+    double timeSlice(int index, double now) override {
+        (void)index;
+        (void)now;
+        return kind == POLICY_RR ? quantum : 0;
+    }
+
+private:
+    struct Entry {
+        double key;
+        long sequence;
+        int index;
+        bool operator>(const Entry& other) const {
+            return key != other.key ? key > other.key : sequence > other.sequence;
+        }
+    };
+
+    PolicyKind kind;
+    double quantum;
+    long sequence = 0;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+};
+
+/**
+ * Creates one of the classic policies for the engine
+ * @param kind Policy to create
+ * @return Newly created policy
+ */
+std::unique_ptr<SchedulerPolicy> makePolicy(PolicyKind kind) {
+    return std::unique_ptr<SchedulerPolicy>(new QueuePolicy(kind));
+}
+
+/**
+ * Overload policy placed in front of the engine's ready queue
+ * A process may be rejected when it arrives or shed when it is about to start
+ */
+class AdmissionController {
+public:
+    virtual ~AdmissionController() {}
+
+    // Display name of the controller
+    virtual std::string name() const = 0;
+
+    // Decides whether an arriving process enters the ready queue
+    // queue_length counts waiting processes; backlog is the CPU work admitted but not yet done
+    virtual bool admit(const Process& process, double now, int queue_length, double backlog) = 0;
+
+    // Decides whether a process about to run for the first time is dropped after 'sojourn' time queued
+    virtual bool shed(const Process& process, double sojourn, double now) {
+        (void)process; (void)sojourn; (void)now;
+        return false;
+    }
+};
+
+/**
+ * How the kernel notices that a time slice has expired
+ */
+enum TimerMode {
+    TIMER_IDEAL,      // Preemption exactly at the quantum boundary, for free
+    TIMER_PERIODIC,   // A tick every 1/HZ; expiry is only seen on a tick and every tick costs CPU
+    TIMER_TICKLESS    // One-shot high-resolution timer programmed per slice; no ticks while idle
+};
+
+/**
+ * Timer subsystem model (times in engine units, taken as milliseconds)
+ */
+struct TimerModel {
+    TimerMode mode = TIMER_IDEAL;
+    int hz = 250;                                       // Tick frequency in periodic mode
+    double tick_cost = TIMER_TICK_COST;                 // CPU time of one tick interrupt
+    double program_cost = HRTIMER_PROGRAM_COST;         // Arming a one-shot timer
+    double expiry_cost = HRTIMER_EXPIRY_COST;           // Handling a one-shot timer interrupt
+
+    double tickPeriod() const { return 1000.0 / hz; }
+};
+
+/**
+ * Runs a process for one slice under the timer model
+ * @param timer Timer model
+ * @param start Time the slice begins
+ * @param slice Quantum granted by the policy (0 = run to completion)
+ * @param remaining CPU work the process still needs
+ * @param work Receives the CPU work actually done
+ * @param interrupts Incremented by the timer interrupts taken
+ * @return Wall-clock duration of the slice including timer overhead
+ */
+double timerSliceDuration(const TimerModel& timer, double start, double slice, double remaining,
+                          double& work, long& interrupts) {
+    double run = slice > 0 ? std::min(slice, remaining) : remaining;
+    if (timer.mode == TIMER_IDEAL) {
+        work = run;
+        return run;
+    }
+    if (timer.mode == TIMER_TICKLESS) {
+        work = run;
+        if (slice <= 0) return run;                 // No timer needed without a quantum
+        double duration = run + timer.program_cost;
+        if (run < remaining) {
+            duration += timer.expiry_cost;
+            interrupts++;
+        }
+        return duration;
+    }
+
+    // Periodic: each tick steals tick_cost; quantum expiry is noticed on the first tick after it
+    double period = timer.tickPeriod();
+    double t = start;
+    work = 0;
+    while (true) {
+        double next_tick = (std::floor(t / period + 1e-9) + 1) * period;
+        if (work + (next_tick - t) >= remaining) {
+            t += remaining - work;
+            work = remaining;
+            return t - start;
+        }
+        work += next_tick - t;
+        t = next_tick + timer.tick_cost;
+        interrupts++;
+        if (slice > 0 && work >= slice - 1e-9) {
+            return t - start;
+        }
+    }
+}
+
+/**
+ * Fairness accumulators for one group of processes, updated as each process completes
+ * Memory is constant however many processes run: slowdown (turnaround / burst) is kept as a
+ * power-of-two histogram and Jain's index from running sums of burst / turnaround
+ */
+struct FairnessGroup {
+    long completed = 0;
+    double share_sum = 0;             // Sum of burst / turnaround
+    double share_sum_squares = 0;
+    double slowdown_sum = 0;
+    double max_slowdown = 0;
+    double max_starvation = 0;        // Longest continuous wait in the ready queue
+    long slowdown_histogram[FAIRNESS_SLOWDOWN_BUCKETS] = {};   // [1,2), [2,4), ... last bucket open-ended
+
+    void recordCompletion(double burst, double turnaround) {
+        double slowdown = burst > 0 && turnaround > 0 ? turnaround / burst : 1;
+        double share = 1 / slowdown;
+        completed++;
+        share_sum += share;
+        share_sum_squares += share * share;
+        slowdown_sum += slowdown;
+        max_slowdown = std::max(max_slowdown, slowdown);
+        slowdown_histogram[slowdownBucket(slowdown)]++;
+    }
+
+    void recordWait(double wait) { max_starvation = std::max(max_starvation, wait); }
+
+    // 1 when every process gets the same share of its time in the system, 1/n when one gets it all
+    double jainIndex() const {
+        return share_sum_squares > 0 ? share_sum * share_sum / (completed * share_sum_squares) : 1;
+    }
+
+    double meanSlowdown() const { return completed ? slowdown_sum / completed : 0; }
+
+    // Upper bound of the histogram bucket holding the p-th quantile
+    double slowdownPercentile(double p) const {
+        long rank = std::max(1L, static_cast<long>(std::ceil(p * completed)));
+        long seen = 0;
+        for (int b = 0; b < FAIRNESS_SLOWDOWN_BUCKETS - 1; b++) {
+            seen += slowdown_histogram[b];
+            if (seen >= rank) return std::min(max_slowdown, std::ldexp(1.0, b + 1));
+        }
+        return max_slowdown;
+    }
+
+    static int slowdownBucket(double slowdown) {
+        int exponent;
+        std::frexp(std::max(1.0, slowdown), &exponent);   // slowdown in [2^(exponent-1), 2^exponent)
+        return std::min(FAIRNESS_SLOWDOWN_BUCKETS - 1, exponent - 1);
+    }
+};
+
+/**
+ * Fairness of an engine run, overall and per priority level
+ */
+struct FairnessStats {
+    FairnessGroup overall;
+    std::vector<FairnessGroup> by_priority;   // Index priority - MIN_PRIORITY (out-of-range priorities clamp)
+    int most_starved = -1;                    // Index of the process that waited longest without running
+
+    FairnessGroup& group(int priority) {
+        int level = std::clamp(priority - MIN_PRIORITY, 0, static_cast<int>(by_priority.size()) - 1);
+        return by_priority[level];
+    }
+};
+
+/**
+ * Windowed time series of an engine run, stored by column
+ * Simulated time is cut into fixed windows; each window keeps time-weighted areas and counters,
+ * so memory grows with run length / window width and not with the number of events
+ */
+class TelemetrySeries {
+public:
+    explicit TelemetrySeries(double window) : window(window) {}
+
+    double windowWidth() const { return window; }
+    size_t windows() const { return busy.size(); }
+
+    /**
+     * Simulated time a window actually covers: the full width except for the last window,
+     * which ends with the run
+     */
+    double windowSpan(size_t w) const {
+        double span = std::min(window, end_time - w * window);
+        return span > 0 ? span : window;   // An event exactly at the end opens an empty window
+    }
+
+    /**
+     * Adds a constant state over [from, to), split across the windows it spans
+     * @param queue Ready-queue length during the interval
+     * @param in_flight Admitted processes not yet finished
+     * @param busy_fraction Share of the interval the CPU ran processes
+     */
+    void accumulate(double from, double to, double queue, double in_flight, double busy_fraction) {
+        while (from < to) {
+            size_t w = grow(from);
+            double end = std::min(to, (w + 1) * window);
+            double span = end - from;
+            queue_area[w] += queue * span;
+            in_flight_area[w] += in_flight * span;
+            busy[w] += busy_fraction * span;
+            if (end <= from) break;   // Guards against rounding at window edges
+            from = end;
+        }
+        end_time = std::max(end_time, to);
+    }
+
+    void recordArrival(double time) {
+        arrivals[grow(time)]++;
+        end_time = std::max(end_time, time);
+    }
+    void recordCompletion(double time) {
+        completions[grow(time)]++;
+        end_time = std::max(end_time, time);
+    }
+    void observeQueue(double time, int queue) {
+        size_t w = grow(time);
+        queue_max[w] = std::max(queue_max[w], queue);
+    }
+
+    // Per-window values (time averages over the part of the window the run covered)
+    double queueMean(size_t w) const { return queue_area[w] / windowSpan(w); }
+    double inFlightMean(size_t w) const { return in_flight_area[w] / windowSpan(w); }
+    double utilization(size_t w) const { return busy[w] / windowSpan(w); }
+    double throughput(size_t w) const { return completions[w] / windowSpan(w); }
+    double arrivalRate(size_t w) const { return arrivals[w] / windowSpan(w); }
+    int queueMax(size_t w) const { return queue_max[w]; }
+    long completionCount(size_t w) const { return completions[w]; }
+    long arrivalCount(size_t w) const { return arrivals[w]; }
+
+    /**
+     * Writes the series column by column: a header line, then one line per metric holding every window
+     * @param path Output file
+     * @return true if the file was written
+     */
+    bool writeColumns(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            std::cout << "Could not write telemetry: " << path << std::endl;
+            return false;
+        }
+        file << "# window " << window << " windows " << windows() << "\n";
+        auto column = [&](const char* name, auto value) {
+            file << name;
+            for (size_t w = 0; w < windows(); w++) file << " " << value(w);
+            file << "\n";
+        };
+        file << std::setprecision(4);
+        column("arrivals", [&](size_t w) { return arrivals[w]; });
+        column("completions", [&](size_t w) { return completions[w]; });
+        column("utilization", [&](size_t w) { return utilization(w); });
+        column("queue_mean", [&](size_t w) { return queueMean(w); });
+        column("queue_max", [&](size_t w) { return queue_max[w]; });
+        column("in_flight_mean", [&](size_t w) { return inFlightMean(w); });
+        return static_cast<bool>(file);
+    }
+
+private:
+    size_t grow(double time) {
+        size_t w = static_cast<size_t>(std::max(0.0, time) / window);
+        if (w >= busy.size()) {
+            queue_area.resize(w + 1, 0);
+            in_flight_area.resize(w + 1, 0);
+            busy.resize(w + 1, 0);
+            queue_max.resize(w + 1, 0);
+            arrivals.resize(w + 1, 0);
+            completions.resize(w + 1, 0);
+        }
+        return w;
+    }
+
+    double window;
+    double end_time = 0;   // Latest time any interval or event reached
+    std::vector<double> queue_area, in_flight_area, busy;
+    std::vector<int> queue_max;
+    std::vector<long> arrivals, completions;
+};
+
+/**
+ * Live counters of one policy, exported by the metrics endpoint
+ * Engine threads only ever add to or store these atomics (relaxed), so a scrape never blocks a run
+ */
+struct PolicyMetrics {
+    std::atomic<int> state{0};                  // 0 = free, 1 = being claimed, 2 = ready
+    char name[PROMETHEUS_NAME_LENGTH] = {};
+    std::atomic<uint64_t> runs{0};
+    std::atomic<uint64_t> dispatches{0};
+    std::atomic<uint64_t> completions{0};
+    std::atomic<uint64_t> context_switches{0};
+    std::atomic<double> simulated_time{0};      // Simulated time advanced, summed over runs
+    std::atomic<int64_t> queue_depth{0};        // Ready-queue length at the latest flush
+    std::atomic<uint64_t> wait_buckets[std::size(PROMETHEUS_WAIT_BUCKETS) + 1] = {};   // Last is +Inf
+    std::atomic<double> wait_sum{0};
+};
+
+/**
+ * Process-wide metrics registry; policies get a slot the first time they run with the endpoint on
+ */
+struct MetricsRegistry {
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> scrapes{0};
+    PolicyMetrics policies[PROMETHEUS_MAX_POLICIES];
+    std::mutex claim;   // Serializes slot claims only; lookups, updates and scrapes never take it
+
+    /**
+     * Finds or claims the slot of a policy
+     * @param policy_name Display name of the policy (label value)
+     * @return Slot, or nullptr if the endpoint is off or every slot is taken
+     */
+    PolicyMetrics* policy(const std::string& policy_name) {
+        if (!enabled.load(std::memory_order_relaxed)) return nullptr;
+        std::string name = policy_name.substr(0, PROMETHEUS_NAME_LENGTH - 1);
+        if (PolicyMetrics* slot = find(name)) return slot;   // Common case: already claimed, no lock
+        std::lock_guard<std::mutex> lock(claim);
+        if (PolicyMetrics* slot = find(name)) return slot;   // Claimed by another thread meanwhile
+        for (PolicyMetrics& slot : policies) {
+            if (slot.state.load(std::memory_order_relaxed) == 0) {
+                slot.state.store(1, std::memory_order_relaxed);
+                std::copy(name.begin(), name.end(), slot.name);
+                slot.state.store(2, std::memory_order_release);
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    // Published slots never change name, so an acquire load of the state makes the name safe to read
+    PolicyMetrics* find(const std::string& name) {
+        for (PolicyMetrics& slot : policies) {
+            if (slot.state.load(std::memory_order_acquire) == 2 && name == slot.name) return &slot;
+        }
+        return nullptr;
+    }
+};
+
+MetricsRegistry& metricsRegistry() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+/**
+ * Engine-side buffer: counts locally and publishes to the shared atomics every
+ * PROMETHEUS_FLUSH_EVENTS dispatches, so engine threads rarely touch shared cache lines
+ */
+class MetricsBatch {
+public:
+    explicit MetricsBatch(PolicyMetrics* target) : target(target) {
+        if (target) target->runs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~MetricsBatch() { flush(); }
+
+    bool active() const { return target != nullptr; }
+
+    void dispatch(double now, int queue_length) {
+        dispatches++;
+        queue_depth = queue_length;
+        if (dispatches >= PROMETHEUS_FLUSH_EVENTS) flush();
+        simulated_time += now - last_time;
+        last_time = now;
+    }
+
+    void contextSwitch() { context_switches++; }
+
+    void complete(double wait) {
+        completions++;
+        wait_sum += wait;
+        size_t b = 0;
+        while (b < std::size(PROMETHEUS_WAIT_BUCKETS) && wait > PROMETHEUS_WAIT_BUCKETS[b]) b++;
+        wait_buckets[b]++;
+    }
+
+    void flush() {
+        if (!target) return;
+        target->dispatches.fetch_add(dispatches, std::memory_order_relaxed);
+        target->completions.fetch_add(completions, std::memory_order_relaxed);
+        target->context_switches.fetch_add(context_switches, std::memory_order_relaxed);
+        target->simulated_time.fetch_add(simulated_time, std::memory_order_relaxed);
+        target->wait_sum.fetch_add(wait_sum, std::memory_order_relaxed);
+        target->queue_depth.store(queue_depth, std::memory_order_relaxed);
+        for (size_t b = 0; b < std::size(wait_buckets); b++) {
+            if (wait_buckets[b]) target->wait_buckets[b].fetch_add(wait_buckets[b], std::memory_order_relaxed);
+            wait_buckets[b] = 0;
+        }
+        dispatches = completions = context_switches = 0;
+        simulated_time = wait_sum = 0;
+    }
+
+private:
+    PolicyMetrics* target;
+    uint64_t dispatches = 0, completions = 0, context_switches = 0;
+    uint64_t wait_buckets[std::size(PROMETHEUS_WAIT_BUCKETS) + 1] = {};
+    double simulated_time = 0, wait_sum = 0, last_time = 0;
+    int64_t queue_depth = 0;
+};
+
+/**
+ * Engine tuning knobs
+ */
+struct EngineOptions {
+    double context_switch_cost = 0;             // CPU time lost on every switch between processes
+    AdmissionController* admission = nullptr;   // Optional overload policy in front of the ready queue
+    TimerModel timer;                           // How quantum expiry is detected
+    TelemetrySeries* telemetry = nullptr;       // Optional windowed time series of the run
+};
+
+/**
+ * Per-process and aggregate results of an engine run
+ */
+struct EngineResult {
+    std::vector<double> waiting_time;      // Turnaround minus burst time
+    std::vector<double> turnaround_time;   // Completion minus arrival
+    std::vector<double> response_time;     // First run minus arrival
+    double makespan = 0;                   // Completion time of the last process
+    double busy_time = 0;                  // Time spent running processes
+    long context_switches = 0;
+    std::vector<bool> dropped;             // Rejected on arrival or shed before running
+    int dropped_count = 0;
+    long dispatches = 0;                   // Slices run
+    long timer_interrupts = 0;             // Ticks or one-shot timer interrupts taken
+    double timer_overhead = 0;             // CPU time spent in timer handling while processes ran
+    FairnessStats fairness;                // Streaming Jain's index, slowdown histogram and starvation
+    bool aborted = false;                  // Stopped early because the policy failed
+
+    // Mean waiting time of the processes that ran to completion
+    double averageWaitingTime() const {
+        double total = 0;
+        for (size_t i = 0; i < waiting_time.size(); i++) {
+            if (!dropped[i]) total += waiting_time[i];
+        }
+        int finished = waiting_time.size() - dropped_count;
+        return finished > 0 ? total / finished : 0;
+    }
+};
+
+/**
+ * Discrete-event single-CPU simulation engine
+ * Processes arrive at their arrival_time and are run in the order chosen by the policy
+ * @param processes Workload to simulate
+ * @param policy Scheduling policy deciding which ready process runs
+ * @param options Engine tuning knobs
+ * @return Per-process times and aggregate counters
+ */
+EngineResult simulateWorkload(const std::vector<Process>& processes, SchedulerPolicy& policy,
+                              const EngineOptions& options = EngineOptions()) {
+    int N = processes.size();
+    EngineResult result;
+    result.waiting_time.assign(N, 0);
+    result.turnaround_time.assign(N, 0);
+    result.response_time.assign(N, 0);
+    result.dropped.assign(N, false);
+
+    std::vector<int> order(N);
+    for (int i = 0; i < N; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return processes[a].arrival_time < processes[b].arrival_time;
+    });
+
+    std::vector<double> remaining(N);
+    std::vector<bool> started(N, false);
+    std::vector<double> ready_since(N, 0);   // Start of each process's current wait in the ready queue
+    result.fairness.by_priority.resize(MAX_PRIORITY - MIN_PRIORITY + 1);
+    for (int i = 0; i < N; i++) {
+        remaining[i] = processes[i].burst_time;
+    }
+    auto ready = [&](int i) {
+        const Process& p = processes[i];
+        return ReadyProcess{i, p.pid, p.priority, p.burst_time, p.arrival_time, remaining[i]};
+    };
+
+    int next_arrival = 0;
+    int completed = 0;          // Finished or dropped
+    int queue_length = 0;       // Processes waiting in the policy
+    int in_flight = 0;          // Admitted processes not yet finished (waiting or running)
+    TelemetrySeries* telemetry = options.telemetry;
+    MetricsBatch metrics(metricsRegistry().enabled.load(std::memory_order_relaxed) ? metricsRegistry().policy(policy.name()) : nullptr);
+    double backlog = 0;         // Admitted CPU work not yet done at slice_start
+    double slice_start = 0;     // Arrivals admitted late see the backlog drained by the
+    double slice_end = 0;       // part of the current slice that ran before they arrived
+    auto drop = [&](int i) {
+        result.dropped[i] = true;
+        result.dropped_count++;
+        completed++;
+    };
+    auto admit = [&](double now) {
+        while (next_arrival < N && processes[order[next_arrival]].arrival_time <= now) {
+            int i = order[next_arrival++];
+            const Process& p = processes[i];
+            if (telemetry) telemetry->recordArrival(p.arrival_time);
+            double pending = backlog - std::max(0.0, std::min(p.arrival_time, slice_end) - slice_start);
+            if (options.admission && !options.admission->admit(p, p.arrival_time, queue_length, pending)) {
+                drop(i);
+                continue;
+            }
+            backlog += p.burst_time;
+            queue_length++;
+            in_flight++;
+            // The slice already in the series counted the queue without this arrival
+            if (telemetry) telemetry->accumulate(p.arrival_time, now, 1, 1, 0);
+            ready_since[i] = p.arrival_time;
+            policy.enqueue(ready(i), p.arrival_time);
+        }
+        if (telemetry) telemetry->observeQueue(now, queue_length);
+    };
+
+    double now = 0;
+    int last = -1;
+
+    // Periodic ticks keep firing while the CPU idles; tickless mode stays quiet
+    auto idle = [&](double until) {
+        if (options.timer.mode == TIMER_PERIODIC) {
+            double period = options.timer.tickPeriod();
+            result.timer_interrupts += static_cast<long>(std::floor(until / period) - std::floor(now / period));
+        }
+        if (telemetry) telemetry->accumulate(now, until, queue_length, in_flight, 0);
+        now = until;
+    };
+
+    while (completed < N) {
+        admit(now);
+        if (policy.empty()) {
+            if (next_arrival < N) {
+                idle(processes[order[next_arrival]].arrival_time);
+            }
+            continue;
+        }
+
+        int job = policy.pickNext(now);
+        if (policy.failed()) {
+            result.aborted = true;
+            break;
+        }
+        if (job == -1) {
+            // Everything queued is ineligible (e.g. throttled): idle until something changes
+            double wake = policy.nextEligibleTime(now);
+            if (next_arrival < N) wake = std::min(wake, processes[order[next_arrival]].arrival_time);
+            idle(std::max(now, wake));
+            continue;
+        }
+        queue_length--;
+
+        if (!started[job] && options.admission &&
+            options.admission->shed(processes[job], now - processes[job].arrival_time, now)) {
+            backlog -= remaining[job];
+            in_flight--;
+            drop(job);
+            continue;
+        }
+
+        double wait = now - ready_since[job];
+        if (wait > result.fairness.overall.max_starvation) result.fairness.most_starved = job;
+        result.fairness.overall.recordWait(wait);
+        result.fairness.group(processes[job].priority).recordWait(wait);
+
+        if (last != -1 && last != job) {
+            result.context_switches++;
+            if (metrics.active()) metrics.contextSwitch();
+            if (telemetry) telemetry->accumulate(now, now + options.context_switch_cost, queue_length, in_flight, 0);
+            now += options.context_switch_cost;
+        }
+        if (!started[job]) {
+            started[job] = true;
+            result.response_time[job] = now - processes[job].arrival_time;
+        }
+
+        double slice = policy.timeSlice(job, now);
+        double run;
+        double duration = timerSliceDuration(options.timer, now, slice, remaining[job], run, result.timer_interrupts);
+        result.timer_overhead += duration - run;
+        result.dispatches++;
+        slice_start = now;
+        now += duration;
+        slice_end = now;
+        remaining[job] -= run;
+        result.busy_time += run;
+        if (telemetry && duration > 0) telemetry->accumulate(slice_start, now, queue_length, in_flight, run / duration);
+        if (metrics.active()) metrics.dispatch(now, queue_length);
+
+        // Arrivals during the slice queue ahead of the preempted process
+        admit(now);
+        backlog -= run;
+        slice_start = slice_end = now;
+        policy.onTick(job, run, now);
+        if (remaining[job] <= 1e-9) {
+            remaining[job] = 0;
+            result.turnaround_time[job] = now - processes[job].arrival_time;
+            result.waiting_time[job] = result.turnaround_time[job] - processes[job].burst_time;
+            result.fairness.overall.recordCompletion(processes[job].burst_time, result.turnaround_time[job]);
+            result.fairness.group(processes[job].priority).recordCompletion(processes[job].burst_time, result.turnaround_time[job]);
+            policy.onComplete(job, now);
+            completed++;
+            in_flight--;
+            if (telemetry) telemetry->recordCompletion(now);
+            if (metrics.active()) metrics.complete(result.waiting_time[job]);
+        } else {
+            queue_length++;
+            ready_since[job] = now;
+            policy.enqueue(ready(job), now);
+        }
+        last = job;
+    }
+
+    result.makespan = now;
+    return result;
+}
+
+/**
+ * Hierarchical fair-share (cgroup-like) policy
+ * Groups form a tree; each level divides CPU between runnable children in proportion to
+ * their shares by always picking the child with the smallest weighted virtual runtime.
+ * Groups may carry a CFS-style bandwidth quota (runtime per period) and are throttled
+ * until the next period once it is used up. Processes live in leaf groups.
+ */
+class FairSharePolicy : public SchedulerPolicy {
+public:
+    FairSharePolicy() {
+        nodes.push_back(Group{"root", -1, FAIR_SHARE_DEFAULT_SHARES, 0, FAIR_SHARE_PERIOD});
+    }
+
+    /**
+     * Adds a group to the hierarchy
+     * @param parent Parent group (0 = root)
+     * @param name Display name
+     * @param shares Relative weight among siblings
+     * @param quota CPU fraction allowed per period (0 = unlimited)
+     * @return Group ID
+     */
+    int addGroup(int parent, const std::string& name, int shares, double quota = 0) {
+        nodes.push_back(Group{name, parent, shares, quota * FAIR_SHARE_PERIOD, FAIR_SHARE_PERIOD});
+        int id = nodes.size() - 1;
+        nodes[parent].children.push_back(id);
+        return id;
+    }
+
+    // Places a process (by workload index) in a leaf group; must precede its first enqueue
+    void assign(int index, int group) {
+        if (index >= static_cast<int>(process_group.size())) {
+            process_group.resize(index + 1, 0);
+            process_vruntime.resize(index + 1, 0);
+        }
+        process_group[index] = group;
+    }
+
+    // Name of the leaf group a process was assigned to
+    const std::string& groupName(int index) const { return nodes[process_group[index]].name; }
+
+    std::string name() const override { return "Hierarchical Fair-Share"; }
+
+    void enqueue(const ReadyProcess& process, double now) override {
+        refreshPeriods(now);
+        int group = process_group[process.index];
+        Group& leaf = nodes[group];
+        process_vruntime[process.index] = std::max(process_vruntime[process.index], leaf.min_vruntime);
+        leaf.processes.insert(std::make_pair(process_vruntime[process.index], process.index));
+        for (int g = group; g != -1; g = nodes[g].parent) {
+            nodes[g].queued++;
+            updateMembership(g);
+        }
+    }
+
+    int pickNext(double now) override {
+        refreshPeriods(now);
+        int g = 0;
+        if (nodes[0].throttled || nodes[0].queued == 0) return -1;
+        if (nodes[0].runnable.empty()) {
+            // Idling is only correct when every queued process sits under a throttled group
+            if (!allQueuedThrottled()) std::cout << "Fair-share: CPU idled while an unthrottled group had work" << std::endl;
+            return -1;
+        }
+        // One O(log children) lookup per level; membership guarantees every step has a child
+        while (nodes[g].processes.empty()) {
+            int child = nodes[g].runnable.begin()->second;
+            nodes[g].min_vruntime = std::max(nodes[g].min_vruntime, nodes[child].vruntime);
+            g = child;
+        }
+        auto first = nodes[g].processes.begin();
+        int index = first->second;
+        nodes[g].min_vruntime = std::max(nodes[g].min_vruntime, first->first);
+        nodes[g].processes.erase(first);
+        for (int n = g; n != -1; n = nodes[n].parent) {
+            nodes[n].queued--;
+            updateMembership(n);
+        }
+        return index;
+    }
+
+    bool empty() const override { return nodes[0].queued == 0; }
+
+    double timeSlice(int index, double now) override {
+        (void)now;
+        double slice = QUANTUM;
+        for (int g = process_group[index]; g != -1; g = nodes[g].parent) {
+            if (nodes[g].quota > 0) slice = std::min(slice, nodes[g].quota - nodes[g].used);
+        }
+        return std::max(slice, 1e-6);
+    }
+
+    void onTick(int index, double ran, double now) override {
+        process_vruntime[index] += ran;
+        for (int g = process_group[index]; g != -1; g = nodes[g].parent) {
+            Group& group = nodes[g];
+            // Running groups are out of their parent's tree, so keys can change freely
+            bool member = group.in_parent;
+            if (member) setMembership(g, false);
+            group.vruntime += ran * FAIR_SHARE_DEFAULT_SHARES / group.shares;
+            group.cpu_time += ran;
+            if (now <= measurement_window) group.window_cpu_time += ran;
+            if (group.quota > 0) {
+                group.used += ran;
+                if (group.used >= group.quota - 1e-9) {
+                    group.throttled = true;
+                    group.throttle_count++;
+                }
+            }
+            updateMembership(g);
+        }
+    }
+
+    double nextEligibleTime(double now) const override {
+        double wake = std::numeric_limits<double>::max();
+        for (const Group& group : nodes) {
+            if (group.throttled) wake = std::min(wake, group.period_end);
+        }
+        return std::max(now, wake);
+    }
+
+    // CPU time consumed within [0, window] is recorded separately for share reports
+    void setMeasurementWindow(double window) { measurement_window = window; }
+
+    /**
+     * Prints the hierarchy with entitled and observed CPU shares
+     * @param processes Workload the policy ran
+     * @param result Engine result for the run
+     */
+    void displayGroups(const std::vector<Process>& processes, const EngineResult& result) const {
+        std::cout << std::setw(22) << std::left << "Group" << std::right
+                  << std::setw(7) << "Shares" << std::setw(7) << "Quota"
+                  << std::setw(9) << "Entitled" << std::setw(9) << "Observed"
+                  << std::setw(10) << "Throttled" << std::setw(9) << "Avg WT" << std::endl;
+        std::cout << std::string(73, '-') << std::endl;
+        // Observed share is CPU time over wall-clock time in the window, so quotas compare directly
+        double window_total = std::min(measurement_window, result.makespan);
+
+        // Depth-first so that every group is listed under its parent
+        std::vector<std::pair<int, int>> stack;   // (group, depth)
+        for (auto it = nodes[0].children.rbegin(); it != nodes[0].children.rend(); ++it) {
+            stack.push_back(std::make_pair(*it, 1));
+        }
+        while (!stack.empty()) {
+            int g = stack.back().first;
+            int depth = stack.back().second;
+            stack.pop_back();
+            const Group& group = nodes[g];
+            for (auto it = group.children.rbegin(); it != group.children.rend(); ++it) {
+                stack.push_back(std::make_pair(*it, depth + 1));
+            }
+
+            // Entitlement multiplies down the path, capped by each quota along the way
+            std::vector<int> path;
+            for (int n = g; nodes[n].parent != -1; n = nodes[n].parent) path.push_back(n);
+            double entitled = 1;
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                const Group& n = nodes[*it];
+                int sibling_shares = 0;
+                for (int s : nodes[n.parent].children) sibling_shares += nodes[s].shares;
+                entitled *= static_cast<double>(n.shares) / sibling_shares;
+                if (n.quota > 0) entitled = std::min(entitled, n.quota / n.period);
+            }
+            double waiting = 0;
+            int members = 0;
+            for (int i = 0; i < static_cast<int>(processes.size()); i++) {
+                for (int n = process_group[i]; n != -1; n = nodes[n].parent) {
+                    if (n == g) {
+                        waiting += result.waiting_time[i];
+                        members++;
+                        break;
+                    }
+                }
+            }
+            std::string label = std::string(2 * (depth - 1), ' ') + group.name;
+            std::cout << std::setw(22) << std::left << label << std::right
+                      << std::setw(7) << group.shares
+                      << std::setw(7) << (group.quota > 0 ? std::to_string(static_cast<int>(100 * group.quota / group.period)) + "%" : "-")
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(8) << 100 * entitled << "%"
+                      << std::setw(8) << (window_total > 0 ? 100 * group.window_cpu_time / window_total : 0) << "%"
+                      << std::setw(10) << group.throttle_count
+                      << std::setprecision(2) << std::setw(9) << (members ? waiting / members : 0) << std::endl;
+        }
+    }
+
+private:
+    struct Group {
+        std::string name;
+        int parent;
+        int shares;
+        double quota;          // Runtime allowed per period (0 = unlimited)
+        double period;
+        std::vector<int> children;
+        std::set<std::pair<double, int>> runnable;    // Runnable child groups by vruntime
+        std::set<std::pair<double, int>> processes;   // Queued processes by vruntime (leaves)
+        double vruntime = 0;
+        double min_vruntime = 0;
+        int queued = 0;            // Queued processes in this subtree
+        bool in_parent = false;    // Currently in the parent's runnable set
+        bool throttled = false;
+        double used = 0;           // Runtime used in the current period
+        double period_end = FAIR_SHARE_PERIOD;
+        int throttle_count = 0;
+        double cpu_time = 0;
+        double window_cpu_time = 0;
+
+        Group(const std::string& name, int parent, int shares, double quota, double period)
+            : name(name), parent(parent), shares(shares), quota(quota), period(period) {}
+    };
+
+    void setMembership(int g, bool member) {
+        Group& group = nodes[g];
+        if (group.parent == -1 || group.in_parent == member) return;
+        Group& parent = nodes[group.parent];
+        if (member) {
+            // A group waking up may not claim CPU it "saved" while idle
+            group.vruntime = std::max(group.vruntime, parent.min_vruntime);
+            parent.runnable.insert(std::make_pair(group.vruntime, g));
+        } else {
+            parent.runnable.erase(std::make_pair(group.vruntime, g));
+        }
+        group.in_parent = member;
+    }
+
+    /**
+     * A group competes in its parent only if it can run something right now: a leaf needs queued
+     * processes, an inner group a runnable child. A change is propagated up the ancestors, so a
+     * parent whose work all sits in throttled children leaves the tree instead of blocking siblings
+     */
+    void updateMembership(int g) {
+        for (; g != -1; g = nodes[g].parent) {
+            const Group& group = nodes[g];
+            bool member = !group.throttled && (!group.processes.empty() || !group.runnable.empty());
+            if (group.parent == -1 || group.in_parent == member) return;
+            setMembership(g, member);
+        }
+    }
+
+    // True if every queued process has a throttled group on its path to the root
+    bool allQueuedThrottled() const {
+        for (int leaf = 0; leaf < static_cast<int>(nodes.size()); leaf++) {
+            if (nodes[leaf].processes.empty()) continue;
+            bool throttled = false;
+            for (int g = leaf; g != -1 && !throttled; g = nodes[g].parent) throttled = nodes[g].throttled;
+            if (!throttled) return false;
+        }
+        return true;
+    }
+
+    // Starts new bandwidth periods and unthrottles groups whose period has elapsed
+    void refreshPeriods(double now) {
+        for (int g = 0; g < static_cast<int>(nodes.size()); g++) {
+            Group& group = nodes[g];
+            if (group.quota <= 0 || now < group.period_end) continue;
+            group.used = 0;
+            group.period_end = (std::floor(now / group.period) + 1) * group.period;
+            if (group.throttled) {
+                group.throttled = false;
+                updateMembership(g);
+            }
+        }
+    }
+
+    std::vector<Group> nodes;
+    std::vector<int> process_group;
+    std::vector<double> process_vruntime;
+    double measurement_window = std::numeric_limits<double>::max();
+};
+
+/**
+ * Hierarchical Fair-Share Scheduling
+ * Generalizes multilevel queues to a tree of tenants and services with shares and quotas
+ * @param processes Vector of processes to schedule
+ * @return Average waiting time
+ */
+double hierarchical_fair_share_scheduling(const std::vector<Process>& processes) {
+    FairSharePolicy policy;
+    int tenant_a = policy.addGroup(0, "tenant-a", 2048);
+    int tenant_b = policy.addGroup(0, "tenant-b", 1024);
+    std::vector<int> leaves;
+    leaves.push_back(policy.addGroup(tenant_a, "web", 1024));
+    leaves.push_back(policy.addGroup(tenant_a, "batch", 512, 0.25));
+    leaves.push_back(policy.addGroup(tenant_b, "analytics", 1024, 0.2));
+    leaves.push_back(policy.addGroup(tenant_b, "reports", 1024));
+
+    // Processes are spread across the leaf groups round-robin by PID
+    for (int i = 0; i < static_cast<int>(processes.size()); i++) {
+        policy.assign(i, leaves[processes[i].pid % leaves.size()]);
+    }
+    policy.setMeasurementWindow(total_burst_time(processes) / 2);
+    EngineResult result = simulateWorkload(processes, policy);
+
+    std::cout << "\n" << std::string(73, '=') << std::endl;
+    std::cout << "HIERARCHICAL FAIR-SHARE SCHEDULING (Period = " << FAIR_SHARE_PERIOD << ")" << std::endl;
+    std::cout << std::string(73, '=') << std::endl;
+    std::cout << std::setw(8) << "Process" << std::setw(12) << "Burst Time"
+              << std::setw(14) << "Group" << std::setw(15) << "Waiting Time"
+              << std::setw(18) << "Turnaround Time" << std::endl;
+    std::cout << std::string(73, '-') << std::endl;
+    for (int i = 0; i < static_cast<int>(processes.size()); i++) {
+        std::cout << std::setw(8) << processes[i].pid
+                  << std::setw(12) << processes[i].burst_time
+                  << std::setw(14) << policy.groupName(i)
+                  << std::setw(15) << result.waiting_time[i]
+                  << std::setw(18) << result.turnaround_time[i] << std::endl;
+    }
+    std::cout << std::string(73, '-') << std::endl;
+    std::cout << "CPU shares over the first " << total_burst_time(processes) / 2 << " time units:" << std::endl;
+    policy.displayGroups(processes, result);
+    std::cout << std::string(73, '-') << std::endl;
+
+    double avg_waiting_time = result.averageWaitingTime();
+    std::cout << "Average Waiting Time: " << std::fixed << std::setprecision(2) << avg_waiting_time << std::endl;
+    std::cout << "Average Turnaround Time: " << std::fixed << std::setprecision(2)
+              << summarizeLatencies(result.turnaround_time).mean << std::endl;
+    std::cout << "Makespan (including throttled idle time): " << result.makespan << std::endl;
+    std::cout << std::string(73, '=') << std::endl;
+
+    return avg_waiting_time;
+}
+
+/**
+ * Guest virtual machine: its vCPUs, guest scheduling policy and workload
+ */
+struct VirtualMachine {
+    PolicyKind guest_policy;
+    int vcpus;
+    std::vector<Process> processes;
+};
+
+/**
+ * Results of a two-level (guest on host) scheduling run
+ */
+struct HypervisorResult {
+    std::vector<std::vector<double>> waiting_time;   // Guest-visible waiting time per VM and process
+    long runnable_ticks = 0;             // Ticks a vCPU had guest work to run
+    long steal_ticks = 0;                // Runnable ticks spent waiting for a pCPU
+    long spin_ticks = 0;                 // Ticks burned spinning on a guest lock
+    long lock_holder_preemptions = 0;    // Host preemptions of a vCPU inside a critical section
+    int makespan = 0;
+};
+
+/**
+ * Simulates guest schedulers running processes on vCPUs while a host Round Robin
+ * scheduler multiplexes the runnable vCPUs onto physical CPUs
+ * Running guest processes periodically take a guest spinlock; if the host preempts the
+ * holder's vCPU, the other vCPUs of that VM spin without making progress
+ * @param vms Guest machines and their workloads (all processes arrive at time 0)
+ * @param pcpus Number of physical CPUs
+ * @param seed Seed for lock acquisition randomness (use the same seed to compare runs)
+ * @return Guest-visible times and host-level counters
+ */
+HypervisorResult simulate_hypervisor(const std::vector<VirtualMachine>& vms, int pcpus, unsigned seed) {
+    HypervisorResult result;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    struct VcpuState {
+        int vm;
+        int process = -1;       // Guest process currently on this vCPU
+        int slice_left = 0;     // Guest time slice left (counts only while on a pCPU)
+        bool spinning = false;  // Waiting for the guest lock
+        int pcpu = -1;          // Physical CPU running this vCPU, -1 if descheduled
+        bool queued = false;    // In the host run queue
+        int host_slice_left = 0;
+    };
+    struct GuestState {
+        std::unique_ptr<SchedulerPolicy> policy;
+        std::vector<int> remaining;
+        int completed = 0;
+        int lock_holder = -1;   // vCPU holding the guest lock
+        int lock_left = 0;      // Critical section ticks left
+    };
+
+    std::vector<VcpuState> vcpus;
+    std::vector<GuestState> guests(vms.size());
+    int total_processes = 0;
+    for (size_t v = 0; v < vms.size(); v++) {
+        guests[v].policy = makePolicy(vms[v].guest_policy);
+        for (size_t i = 0; i < vms[v].processes.size(); i++) {
+            const Process& p = vms[v].processes[i];
+            guests[v].remaining.push_back(p.burst_time);
+            guests[v].policy->enqueue(ReadyProcess{static_cast<int>(i), p.pid, p.priority, p.burst_time,
+                                                   p.arrival_time, static_cast<double>(p.burst_time)}, 0);
+        }
+        total_processes += vms[v].processes.size();
+        result.waiting_time.push_back(std::vector<double>(vms[v].processes.size(), 0));
+        for (int c = 0; c < vms[v].vcpus; c++) {
+            VcpuState vcpu;
+            vcpu.vm = v;
+            vcpus.push_back(vcpu);
+        }
+    }
+
+    std::vector<int> pcpu_running(pcpus, -1);
+    std::deque<int> host_queue;
+    int completed = 0;
+    int time = 0;
+    while (completed < total_processes) {
+        // Guest schedulers place ready processes on idle vCPUs
+        for (VcpuState& vcpu : vcpus) {
+            GuestState& guest = guests[vcpu.vm];
+            if (vcpu.process == -1 && !guest.policy->empty()) {
+                vcpu.process = guest.policy->pickNext(time);
+                double slice = guest.policy->timeSlice(vcpu.process, time);
+                vcpu.slice_left = slice > 0 ? static_cast<int>(slice) : std::numeric_limits<int>::max();
+            }
+        }
+
+        // Host: idle vCPUs halt and leave their pCPU, runnable ones queue for one
+        for (int c = 0; c < static_cast<int>(vcpus.size()); c++) {
+            VcpuState& vcpu = vcpus[c];
+            if (vcpu.process == -1 && vcpu.pcpu != -1) {
+                pcpu_running[vcpu.pcpu] = -1;
+                vcpu.pcpu = -1;
+            }
+            if (vcpu.process != -1 && vcpu.pcpu == -1 && !vcpu.queued) {
+                host_queue.push_back(c);
+                vcpu.queued = true;
+            }
+        }
+        for (int p = 0; p < pcpus && !host_queue.empty(); p++) {
+            if (pcpu_running[p] != -1) continue;
+            int c = host_queue.front();
+            host_queue.pop_front();
+            vcpus[c].queued = false;
+            vcpus[c].pcpu = p;
+            vcpus[c].host_slice_left = HOST_QUANTUM;
+            pcpu_running[p] = c;
+        }
+
+        // Execute one tick
+        for (int c = 0; c < static_cast<int>(vcpus.size()); c++) {
+            VcpuState& vcpu = vcpus[c];
+            if (vcpu.process == -1) continue;
+            result.runnable_ticks++;
+            if (vcpu.pcpu == -1) {
+                result.steal_ticks++;
+                continue;
+            }
+            vcpu.host_slice_left--;
+
+            GuestState& guest = guests[vcpu.vm];
+            if (guest.lock_holder != c && !vcpu.spinning && uniform(rng) < LOCK_REQUEST_PROBABILITY) {
+                vcpu.spinning = true;
+            }
+            if (vcpu.spinning) {
+                if (guest.lock_holder == -1) {
+                    guest.lock_holder = c;
+                    guest.lock_left = LOCK_HOLD_TICKS;
+                    vcpu.spinning = false;
+                } else {
+                    result.spin_ticks++;
+                    continue;
+                }
+            }
+            if (guest.lock_holder == c && --guest.lock_left <= 0) {
+                guest.lock_holder = -1;
+            }
+            guest.remaining[vcpu.process]--;
+            vcpu.slice_left--;
+        }
+        time++;
+
+        // Guest completions and preemptions, then host slice expiry
+        for (int c = 0; c < static_cast<int>(vcpus.size()); c++) {
+            VcpuState& vcpu = vcpus[c];
+            if (vcpu.process == -1) continue;
+            GuestState& guest = guests[vcpu.vm];
+            const Process& p = vms[vcpu.vm].processes[vcpu.process];
+            if (guest.remaining[vcpu.process] <= 0) {
+                result.waiting_time[vcpu.vm][vcpu.process] = time - p.arrival_time - p.burst_time;
+                guest.policy->onComplete(vcpu.process, time);
+                if (guest.lock_holder == c) guest.lock_holder = -1;
+                vcpu.process = -1;
+                vcpu.spinning = false;
+                completed++;
+            } else if (vcpu.slice_left <= 0 && !guest.policy->empty() && guest.lock_holder != c) {
+                guest.policy->enqueue(ReadyProcess{vcpu.process, p.pid, p.priority, p.burst_time, p.arrival_time,
+                                                   static_cast<double>(guest.remaining[vcpu.process])}, time);
+                vcpu.process = -1;
+                vcpu.spinning = false;
+            } else if (vcpu.slice_left <= 0) {
+                vcpu.slice_left = static_cast<int>(std::max(1.0, guest.policy->timeSlice(vcpu.process, time)));
+            }
+
+            if (vcpu.process != -1 && vcpu.pcpu != -1 && vcpu.host_slice_left <= 0 && !host_queue.empty()) {
+                if (guest.lock_holder == c) result.lock_holder_preemptions++;
+                pcpu_running[vcpu.pcpu] = -1;
+                vcpu.pcpu = -1;
+                host_queue.push_back(c);
+                vcpu.queued = true;
+            }
+        }
+    }
+
+    result.makespan = time;
+    return result;
+}
+
+/**
+ * Two-Level Hypervisor Scheduling Simulation
+ * Sweeps host overcommit and reports how guest-visible waiting times inflate
+ * @param vms Guest machines and their workloads
+ * @return Average guest waiting time at the highest overcommit level
+ */
+double hypervisor_scheduling(const std::vector<VirtualMachine>& vms) {
+    int total_vcpus = 0;
+    for (const VirtualMachine& vm : vms) {
+        total_vcpus += vm.vcpus;
+    }
+
+    std::cout << "\n" << std::string(76, '=') << std::endl;
+    std::cout << "TWO-LEVEL HYPERVISOR SCHEDULING (Host RR Quantum = " << HOST_QUANTUM << ")" << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+    for (size_t v = 0; v < vms.size(); v++) {
+        std::cout << "VM " << v << ": " << vms[v].vcpus << " vCPUs, guest " << policyKindName(vms[v].guest_policy)
+                  << ", " << vms[v].processes.size() << " processes" << std::endl;
+    }
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << std::setw(6) << "pCPUs" << std::setw(11) << "Overcommit" << std::setw(10) << "Avg WT"
+              << std::setw(11) << "Inflation" << std::setw(9) << "p99 WT" << std::setw(9) << "Steal%"
+              << std::setw(11) << "Spin Ticks" << std::setw(9) << "LHP" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    double baseline = 0;
+    double avg_waiting_time = 0;
+    std::vector<std::vector<double>> per_vm_waits;
+    std::vector<int> levels;
+    for (int divisor = 1; divisor <= HOST_MAX_OVERCOMMIT; divisor *= 2) {
+        int pcpus = std::max(1, total_vcpus / divisor);
+        HypervisorResult result = simulate_hypervisor(vms, pcpus, HYPERVISOR_SEED);
+
+        std::vector<double> all_waits;
+        std::vector<double> vm_waits;
+        for (const std::vector<double>& waits : result.waiting_time) {
+            all_waits.insert(all_waits.end(), waits.begin(), waits.end());
+            vm_waits.push_back(summarizeLatencies(waits).mean);
+        }
+        LatencySummary wait = summarizeLatencies(all_waits);
+        if (divisor == 1) baseline = wait.mean;
+        avg_waiting_time = wait.mean;
+
+        std::cout << std::setw(6) << pcpus << std::fixed << std::setprecision(2)
+                  << std::setw(10) << static_cast<double>(total_vcpus) / pcpus << "x"
+                  << std::setw(10) << wait.mean
+                  << std::setw(10) << (baseline > 0 ? wait.mean / baseline : 1.0) << "x"
+                  << std::setw(9) << wait.p99
+                  << std::setw(8) << 100.0 * result.steal_ticks / std::max(1L, result.runnable_ticks) << "%"
+                  << std::setw(11) << result.spin_ticks
+                  << std::setw(9) << result.lock_holder_preemptions << std::endl;
+        per_vm_waits.push_back(vm_waits);
+        levels.push_back(pcpus);
+    }
+
+    std::cout << "\nAverage guest waiting time per VM" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << std::setw(6) << "pCPUs";
+    for (size_t v = 0; v < vms.size(); v++) {
+        std::cout << std::setw(16) << ("VM" + std::to_string(v) + " " + policyKindName(vms[v].guest_policy));
+    }
+    std::cout << std::endl;
+    for (size_t l = 0; l < levels.size(); l++) {
+        std::cout << std::setw(6) << levels[l];
+        for (double w : per_vm_waits[l]) {
+            std::cout << std::setw(16) << w;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(76, '=') << std::endl;
+
+    return avg_waiting_time;
+}
+
+/**
+ * Parallel job made of several threads that synchronize at barriers
+ */
+struct ParallelJob {
+    int id;           // Job ID
+    int threads;      // Threads that must run together
+    int burst_time;   // CPU time each thread needs
+};
+
+typedef std::bitset<MAX_GANG_CPUS> CpuMask;
+
+/**
+ * Generates random parallel jobs
+ * @param num_jobs Number of jobs to generate
+ * @param max_threads Upper bound on threads per job
+ * @return Vector of randomly generated jobs
+ */
+std::vector<ParallelJob> generateParallelJobs(int num_jobs, int max_threads) {
+    std::vector<ParallelJob> jobs;
+    for (int i = 0; i < num_jobs; i++) {
+        int threads = rand() % max_threads + 1;
+        int burst_time = rand() % (MAX_BURST_TIME - MIN_BURST_TIME + 1) + MIN_BURST_TIME;
+        jobs.push_back({i, threads, burst_time});
+    }
+    return jobs;
+}
+
+/**
+ * Results of a parallel-job scheduling run
+ */
+struct GangResult {
+    std::vector<double> turnaround_time;   // Per job
+    int makespan = 0;
+    long busy_cpu_ticks = 0;               // CPU ticks doing useful work
+    long idle_cpu_ticks = 0;               // CPU ticks left idle while jobs were waiting or running
+    long sync_wait_ticks = 0;              // Thread ticks blocked at barriers
+    long alternate_ticks = 0;              // Job ticks run outside their home slot
+};
+
+/**
+ * Gang scheduling with an Ousterhout matrix
+ * Rows are time slots and columns CPUs; all threads of a job share one row and run together.
+ * With alternate scheduling, CPUs left idle in the active row run jobs from other rows
+ * whose whole CPU set is free there, found with a single mask test per job.
+ * @param jobs Parallel jobs to schedule (all arrive at time 0); a gang must fit in one row, so
+ *             jobs with more than num_cpus threads are narrowed to num_cpus
+ * @param num_cpus Number of CPUs (columns, at most MAX_GANG_CPUS)
+ * @param alternate Enable alternate scheduling to fill fragmented slots
+ * @return Per-job turnaround and utilization counters
+ */
+GangResult gang_schedule(const std::vector<ParallelJob>& jobs, int num_cpus, bool alternate) {
+    int N = jobs.size();
+    GangResult result;
+    result.turnaround_time.assign(N, 0);
+
+    num_cpus = std::clamp(num_cpus, 1, MAX_GANG_CPUS);
+    CpuMask machine;
+    for (int c = 0; c < num_cpus; c++) machine.set(c);
+
+    std::vector<CpuMask> slot_used;            // Ousterhout matrix rows
+    std::vector<std::vector<int>> slot_jobs;
+    std::vector<CpuMask> job_cpus(N);
+    std::vector<int> job_slot(N, -1);
+    std::vector<int> remaining(N);
+    std::vector<int> width(N);                 // Threads placed per job; wider jobs could never fit a row
+    std::deque<int> waiting;
+    for (int j = 0; j < N; j++) {
+        remaining[j] = jobs[j].burst_time;
+        width[j] = std::clamp(jobs[j].threads, 1, num_cpus);
+        waiting.push_back(j);
+    }
+
+    // First fit: the first row with enough free columns, or a new row
+    auto place = [&](int j) {
+        for (int s = 0; s <= static_cast<int>(slot_used.size()); s++) {
+            if (s == static_cast<int>(slot_used.size())) {
+                if (s == GANG_MAX_SLOTS) return false;
+                slot_used.push_back(CpuMask());
+                slot_jobs.push_back(std::vector<int>());
+            }
+            CpuMask free_cpus = machine & ~slot_used[s];
+            if (static_cast<int>(free_cpus.count()) < width[j]) continue;
+            CpuMask mask;
+            for (int c = 0, taken = 0; taken < width[j]; c++) {
+                if (free_cpus.test(c)) {
+                    mask.set(c);
+                    taken++;
+                }
+            }
+            slot_used[s] |= mask;
+            slot_jobs[s].push_back(j);
+            job_cpus[j] = mask;
+            job_slot[j] = s;
+            return true;
+        }
+        return false;
+    };
+
+    int time = 0;
+    int completed = 0;
+    int slot = 0;
+    int slot_ticks = 0;
+    while (completed < N) {
+        while (!waiting.empty() && place(waiting.front())) {
+            waiting.pop_front();
+        }
+        // Drop empty rows so the rotation only visits useful slots
+        for (int s = slot_used.size() - 1; s >= 0; s--) {
+            if (!slot_jobs[s].empty()) continue;
+            slot_used.erase(slot_used.begin() + s);
+            slot_jobs.erase(slot_jobs.begin() + s);
+            for (int j = 0; j < N; j++) {
+                if (job_slot[j] > s) job_slot[j]--;
+            }
+            if (slot > s) slot--;
+        }
+        if (slot >= static_cast<int>(slot_used.size())) {
+            slot = 0;
+        }
+
+        // Jobs of the active row, plus alternates that fit in its idle columns
+        std::vector<int> running = slot_jobs[slot];
+        CpuMask busy = slot_used[slot];
+        if (alternate) {
+            for (int s = 0; s < static_cast<int>(slot_used.size()); s++) {
+                if (s == slot) continue;
+                for (int j : slot_jobs[s]) {
+                    if ((job_cpus[j] & busy).none()) {
+                        busy |= job_cpus[j];
+                        running.push_back(j);
+                        result.alternate_ticks++;
+                    }
+                }
+            }
+        }
+
+        result.busy_cpu_ticks += busy.count();
+        result.idle_cpu_ticks += num_cpus - busy.count();
+        for (int j : running) {
+            remaining[j]--;
+        }
+        time++;
+        slot_ticks++;
+
+        for (int j : running) {
+            if (remaining[j] > 0) continue;
+            std::vector<int>& row = slot_jobs[job_slot[j]];
+            row.erase(std::find(row.begin(), row.end(), j));
+            slot_used[job_slot[j]] &= ~job_cpus[j];
+            result.turnaround_time[j] = time;
+            completed++;
+        }
+        if (slot_ticks >= GANG_SLOT_LENGTH || slot_jobs[slot].empty()) {
+            slot = (slot + 1) % slot_used.size();
+            slot_ticks = 0;
+        }
+    }
+
+    result.makespan = time;
+    return result;
+}
+
+/**
+ * Uncoordinated scheduling of parallel jobs
+ * Every thread is an independent Round Robin task on its own CPU; a thread reaching a
+ * barrier blocks until all of its siblings reach it
+ * @param jobs Parallel jobs to schedule (all arrive at time 0)
+ * @param num_cpus Number of CPUs
+ * @return Per-job turnaround and synchronization counters
+ */
+GangResult uncoordinated_schedule(const std::vector<ParallelJob>& jobs, int num_cpus) {
+    int N = jobs.size();
+    GangResult result;
+    result.turnaround_time.assign(N, 0);
+
+    struct Thread {
+        int job;
+        int progress = 0;
+        bool blocked = false;
+        int cpu;
+    };
+    std::vector<Thread> threads;
+    std::vector<std::vector<int>> job_threads(N);
+    std::vector<std::deque<int>> run_queue(num_cpus);
+    std::vector<int> threads_done(N, 0);
+
+    // Spread threads over the least-loaded CPUs
+    for (int j = 0; j < N; j++) {
+        for (int t = 0; t < jobs[j].threads; t++) {
+            int cpu = 0;
+            for (int c = 1; c < num_cpus; c++) {
+                if (run_queue[c].size() < run_queue[cpu].size()) cpu = c;
+            }
+            Thread thread;
+            thread.job = j;
+            thread.cpu = cpu;
+            job_threads[j].push_back(threads.size());
+            run_queue[cpu].push_back(threads.size());
+            threads.push_back(thread);
+        }
+    }
+
+    std::vector<int> running(num_cpus, -1);
+    std::vector<int> slice_left(num_cpus, 0);
+    int time = 0;
+    int completed = 0;
+    while (completed < N) {
+        for (int c = 0; c < num_cpus; c++) {
+            if (running[c] == -1 && !run_queue[c].empty()) {
+                running[c] = run_queue[c].front();
+                run_queue[c].pop_front();
+                slice_left[c] = QUANTUM;
+            }
+        }
+        for (const Thread& thread : threads) {
+            if (thread.blocked) result.sync_wait_ticks++;
+        }
+
+        for (int c = 0; c < num_cpus; c++) {
+            if (running[c] == -1) {
+                result.idle_cpu_ticks++;
+                continue;
+            }
+            result.busy_cpu_ticks++;
+            threads[running[c]].progress++;
+            slice_left[c]--;
+        }
+        time++;
+
+        for (int c = 0; c < num_cpus; c++) {
+            int id = running[c];
+            if (id == -1) continue;
+            Thread& thread = threads[id];
+            const ParallelJob& job = jobs[thread.job];
+            if (thread.progress == job.burst_time) {
+                running[c] = -1;
+                if (++threads_done[thread.job] == job.threads) {
+                    result.turnaround_time[thread.job] = time;
+                    completed++;
+                }
+                continue;
+            }
+            if (thread.progress % GANG_BARRIER_INTERVAL == 0) {
+                // Barrier: block unless every sibling has already arrived
+                bool all_arrived = true;
+                for (int sibling : job_threads[thread.job]) {
+                    if (threads[sibling].progress < thread.progress) all_arrived = false;
+                }
+                if (all_arrived) {
+                    for (int sibling : job_threads[thread.job]) {
+                        if (threads[sibling].blocked) {
+                            threads[sibling].blocked = false;
+                            run_queue[threads[sibling].cpu].push_back(sibling);
+                        }
+                    }
+                } else {
+                    thread.blocked = true;
+                    running[c] = -1;
+                    continue;
+                }
+            }
+            if (slice_left[c] <= 0 && !run_queue[c].empty()) {
+                run_queue[c].push_back(id);
+                running[c] = -1;
+            }
+        }
+    }
+
+    result.makespan = time;
+    return result;
+}
+
+/**
+ * Gang Scheduling Simulation
+ * Compares Ousterhout-matrix gang scheduling against uncoordinated per-thread scheduling
+ * @param jobs Parallel jobs to schedule
+ * @param num_cpus Number of CPUs in the machine
+ * @return Average job turnaround time under gang scheduling with alternates
+ */
+double gang_scheduling(const std::vector<ParallelJob>& jobs, int num_cpus) {
+    num_cpus = std::min(num_cpus, MAX_GANG_CPUS);
+    int total_threads = 0;
+    for (const ParallelJob& job : jobs) {
+        total_threads += job.threads;
+    }
+
+    std::cout << "\n" << std::string(76, '=') << std::endl;
+    std::cout << "GANG SCHEDULING (Slot Length = " << GANG_SLOT_LENGTH << ", Barrier Every "
+              << GANG_BARRIER_INTERVAL << " Ticks)" << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+    std::cout << jobs.size() << " parallel jobs, " << total_threads << " threads on " << num_cpus << " CPUs" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << std::setw(24) << std::left << "Strategy" << std::right
+              << std::setw(9) << "Avg TAT" << std::setw(8) << "p95"
+              << std::setw(10) << "Makespan" << std::setw(8) << "Util%"
+              << std::setw(8) << "Frag%" << std::setw(10) << "Sync Wait" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    const char* names[] = {"Uncoordinated RR", "Gang (Ousterhout)", "Gang + Alternates"};
+    GangResult results[] = {
+        uncoordinated_schedule(jobs, num_cpus),
+        gang_schedule(jobs, num_cpus, false),
+        gang_schedule(jobs, num_cpus, true)
+    };
+    for (int i = 0; i < 3; i++) {
+        const GangResult& r = results[i];
+        LatencySummary turnaround = summarizeLatencies(r.turnaround_time);
+        long cpu_ticks = static_cast<long>(r.makespan) * num_cpus;
+        std::cout << std::setw(24) << std::left << names[i] << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << turnaround.mean << std::setw(8) << turnaround.p95
+                  << std::setw(10) << r.makespan
+                  << std::setw(7) << 100.0 * r.busy_cpu_ticks / cpu_ticks << "%"
+                  << std::setw(7) << 100.0 * r.idle_cpu_ticks / cpu_ticks << "%"
+                  << std::setw(10) << r.sync_wait_ticks << std::endl;
+    }
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << "Frag% is the share of CPU time left idle; Sync Wait counts thread ticks blocked at barriers." << std::endl;
+    std::cout << "Alternate scheduling ran " << results[2].alternate_ticks << " job-ticks outside their home slot." << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+
+    return summarizeLatencies(results[2].turnaround_time).mean;
+}
+
+/**
+ * Block I/O request issued by a process
+ */
+struct DiskRequest {
+    int id;                // Request ID (index in the workload)
+    int process;           // Issuing process
+    double arrival_time;   // Time the request is submitted
+    long block;            // Starting block number
+    int size;              // Length in blocks
+    bool is_read;          // Reads are synchronous and have a tighter deadline
+};
+
+/**
+ * Interface implemented by every block-device request scheduler
+ */
+class DiskScheduler {
+public:
+    virtual ~DiskScheduler() {}
+
+    // Display name of the scheduler
+    virtual std::string name() const = 0;
+
+    // A request was submitted
+    virtual void add(const DiskRequest& request, double now) = 0;
+
+    // Removes and returns the ID of the next request to service
+    virtual int dispatch(long head_block, double now) = 0;
+
+    // True when no request is pending
+    virtual bool empty() const = 0;
+};
+
+/**
+ * Services requests in submission order (noop)
+ */
+class FifoDiskScheduler : public DiskScheduler {
+public:
+    std::string name() const override { return "FIFO (noop)"; }
+    void add(const DiskRequest& request, double now) override { (void)now; queue.push_back(request.id); }
+    int dispatch(long head_block, double now) override {
+        (void)head_block;
+        (void)now;
+        int id = queue.front();
+        queue.pop_front();
+        return id;
+    }
+    bool empty() const override { return queue.empty(); }
+
+private:
+    std::deque<int> queue;
+};
+
+/**
+ * Elevator scheduling over a sorted request tree
+ * LOOK sweeps in one direction and reverses at the last pending request rather than at the
+ * disk edge as SCAN would; C-LOOK only sweeps upwards and jumps back to the lowest pending request
+ */
+class ElevatorDiskScheduler : public DiskScheduler {
+public:
+    explicit ElevatorDiskScheduler(bool circular) : circular(circular) {}
+
+    std::string name() const override { return circular ? "C-LOOK" : "LOOK (Elevator)"; }
+
+    void add(const DiskRequest& request, double now) override {
+        (void)now;
+        sorted.insert(std::make_pair(request.block, request.id));
+    }
+
+    int dispatch(long head_block, double now) override {
+        (void)now;
+        auto it = sorted.lower_bound(std::make_pair(head_block, -1));
+        if (circular) {
+            if (it == sorted.end()) it = sorted.begin();
+        } else {
+            if (upward && it == sorted.end()) upward = false;
+            if (!upward) {
+                auto below = sorted.upper_bound(std::make_pair(head_block, std::numeric_limits<int>::max()));
+                if (below == sorted.begin()) {
+                    upward = true;
+                } else {
+                    it = std::prev(below);
+                }
+            }
+        }
+        int id = it->second;
+        sorted.erase(it);
+        return id;
+    }
+
+    bool empty() const override { return sorted.empty(); }
+
+private:
+    bool circular;
+    bool upward = true;
+    std::set<std::pair<long, int>> sorted;
+};
+
+/**
+ * Deadline scheduler
+ * Keeps a sorted tree and a FIFO expiry list per direction (read/write). Requests are
+ * dispatched in sorted batches; reads are preferred unless writes have been starved,
+ * and an expired FIFO head restarts the batch from the oldest request.
+ */
+class DeadlineDiskScheduler : public DiskScheduler {
+public:
+    std::string name() const override { return "Deadline"; }
+
+    void add(const DiskRequest& request, double now) override {
+        int dir = request.is_read ? 0 : 1;
+        double expire = now + (request.is_read ? DEADLINE_READ_EXPIRE : DEADLINE_WRITE_EXPIRE);
+        sorted[dir].insert(std::make_pair(request.block, request.id));
+        fifo[dir].push_back(std::make_pair(expire, request));
+        pending++;
+    }
+
+    int dispatch(long head_block, double now) override {
+        // Continue the current batch while it has requests ahead of the head
+        if (batch_left > 0) {
+            auto it = sorted[batch_dir].lower_bound(std::make_pair(head_block, -1));
+            if (it != sorted[batch_dir].end()) {
+                batch_left--;
+                return take(batch_dir, it);
+            }
+        }
+
+        int dir;
+        bool reads = !sorted[0].empty();
+        bool writes = !sorted[1].empty();
+        if (reads && (!writes || writes_starved < DEADLINE_WRITES_STARVED)) {
+            dir = 0;
+            if (writes) writes_starved++;
+        } else {
+            dir = 1;
+            writes_starved = 0;
+        }
+
+        dropDispatched(dir);
+        auto it = sorted[dir].lower_bound(std::make_pair(head_block, -1));
+        if (fifo[dir].front().first <= now || it == sorted[dir].end()) {
+            const DiskRequest& oldest = fifo[dir].front().second;
+            it = sorted[dir].find(std::make_pair(oldest.block, oldest.id));
+        }
+        batch_dir = dir;
+        batch_left = DEADLINE_FIFO_BATCH - 1;
+        return take(dir, it);
+    }
+
+    bool empty() const override { return pending == 0; }
+
+private:
+    int take(int dir, std::set<std::pair<long, int>>::iterator it) {
+        int id = it->second;
+        sorted[dir].erase(it);
+        dispatched.insert(id);
+        pending--;
+        return id;
+    }
+
+    // FIFO entries are removed lazily once their request was dispatched from the tree
+    void dropDispatched(int dir) {
+        while (!fifo[dir].empty() && dispatched.count(fifo[dir].front().second.id)) {
+            dispatched.erase(fifo[dir].front().second.id);
+            fifo[dir].pop_front();
+        }
+    }
+
+    std::set<std::pair<long, int>> sorted[2];
+    std::deque<std::pair<double, DiskRequest>> fifo[2];
+    std::set<int> dispatched;
+    int pending = 0;
+    int batch_dir = 0;
+    int batch_left = 0;
+    int writes_starved = 0;
+};
+
+/**
+ * BFQ-like proportional-share scheduler
+ * Each process has its own sorted queue. The backlogged process with the smallest
+ * virtual time (service received / weight) becomes active and is served in block
+ * order until it exhausts its budget or its queue, so a sequential stream keeps
+ * its locality while every process gets a fair share of the disk.
+ */
+class BfqDiskScheduler : public DiskScheduler {
+public:
+    explicit BfqDiskScheduler(const std::vector<int>& weights) : weights(weights), queues(weights.size()),
+        virtual_time(weights.size(), 0) {}
+
+    std::string name() const override { return "BFQ-like"; }
+
+    void add(const DiskRequest& request, double now) override {
+        (void)now;
+        int p = request.process;
+        if (queues[p].empty() && p != active) {
+            virtual_time[p] = std::max(virtual_time[p], system_virtual_time);
+            backlogged.insert(std::make_pair(virtual_time[p], p));
+        }
+        queues[p].insert(std::make_pair(request.block, std::make_pair(request.id, request.size)));
+        pending++;
+    }
+
+    int dispatch(long head_block, double now) override {
+        (void)now;
+        if (active == -1 || queues[active].empty() || budget_left <= 0) {
+            if (active != -1 && !queues[active].empty()) {
+                backlogged.insert(std::make_pair(virtual_time[active], active));
+            }
+            active = backlogged.begin()->second;
+            system_virtual_time = backlogged.begin()->first;
+            backlogged.erase(backlogged.begin());
+            budget_left = BFQ_MAX_BUDGET;
+        }
+        auto& queue = queues[active];
+        auto it = queue.lower_bound(std::make_pair(head_block, std::make_pair(-1, 0)));
+        if (it == queue.end()) it = queue.begin();
+        int id = it->second.first;
+        int size = it->second.second;
+        queue.erase(it);
+        budget_left -= size;
+        virtual_time[active] += static_cast<double>(size) / weights[active];
+        pending--;
+        return id;
+    }
+
+    bool empty() const override { return pending == 0; }
+
+private:
+    std::vector<int> weights;
+    std::vector<std::set<std::pair<long, std::pair<int, int>>>> queues;   // block -> (id, size)
+    std::vector<double> virtual_time;
+    std::set<std::pair<double, int>> backlogged;
+    double system_virtual_time = 0;
+    int active = -1;
+    int budget_left = 0;
+    int pending = 0;
+};
+
+/**
+ * Generates a mixed storage workload
+ * Process 0 and 1 read sequentially, process 2 reads randomly and process 3 writes randomly
+ * @param num_requests Number of requests to generate
+ * @param seed Random seed
+ * @return Requests sorted by arrival time
+ */
+std::vector<DiskRequest> generateDiskRequests(int num_requests, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> interarrival(1.0 / DISK_MEAN_INTERARRIVAL);
+    std::uniform_int_distribution<long> any_block(0, DISK_CYLINDERS * DISK_BLOCKS_PER_CYLINDER - 1);
+    std::uniform_int_distribution<int> size(1, DISK_MAX_REQUEST_BLOCKS);
+
+    std::vector<long> next_block = {any_block(rng), any_block(rng)};
+    std::vector<DiskRequest> requests;
+    double time = 0;
+    for (int i = 0; i < num_requests; i++) {
+        time += interarrival(rng);
+        int process = i % DISK_PROCESSES;
+        DiskRequest request{i, process, time, 0, size(rng), process != 3};
+        if (process < 2) {
+            request.block = next_block[process];
+            next_block[process] += request.size;
+        } else {
+            request.block = any_block(rng);
+        }
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+/**
+ * Results of a disk scheduling run
+ */
+struct DiskResult {
+    std::vector<double> latency;                // Per request: completion minus arrival
+    std::vector<double> process_latency;        // Mean latency per process
+    double makespan = 0;
+    double busy_time = 0;
+    long seek_cylinders = 0;                    // Total head travel
+    int read_deadline_misses = 0;               // Reads slower than DEADLINE_READ_EXPIRE
+};
+
+/**
+ * Discrete-event single-disk simulation
+ * Service time = seek (sqrt of cylinder distance) + rotational latency + transfer;
+ * a request starting where the previous one ended skips seek and rotation
+ * @param requests Workload sorted by arrival time
+ * @param scheduler Request scheduler deciding the service order
+ * @return Per-request latencies and device counters
+ */
+DiskResult simulateDisk(const std::vector<DiskRequest>& requests, DiskScheduler& scheduler) {
+    int N = requests.size();
+    DiskResult result;
+    result.latency.assign(N, 0);
+    std::vector<int> per_process(DISK_PROCESSES, 0);
+    result.process_latency.assign(DISK_PROCESSES, 0);
+
+    double now = 0;
+    long head_block = 0;
+    int next = 0;
+    int completed = 0;
+    while (completed < N) {
+        while (next < N && requests[next].arrival_time <= now) {
+            scheduler.add(requests[next], requests[next].arrival_time);
+            next++;
+        }
+        if (scheduler.empty()) {
+            now = requests[next].arrival_time;
+            continue;
+        }
+
+        const DiskRequest& request = requests[scheduler.dispatch(head_block, now)];
+        double service = request.size * DISK_TRANSFER_PER_BLOCK;
+        if (request.block != head_block) {
+            long distance = std::labs(request.block / DISK_BLOCKS_PER_CYLINDER - head_block / DISK_BLOCKS_PER_CYLINDER);
+            if (distance > 0) service += DISK_SEEK_BASE + DISK_SEEK_FACTOR * std::sqrt(static_cast<double>(distance));
+            service += DISK_ROTATIONAL_LATENCY;
+            result.seek_cylinders += distance;
+        }
+        now += service;
+        result.busy_time += service;
+        head_block = request.block + request.size;
+
+        double latency = now - request.arrival_time;
+        result.latency[request.id] = latency;
+        result.process_latency[request.process] += latency;
+        per_process[request.process]++;
+        if (request.is_read && latency > DEADLINE_READ_EXPIRE) result.read_deadline_misses++;
+        completed++;
+    }
+    for (int p = 0; p < DISK_PROCESSES; p++) {
+        if (per_process[p] > 0) result.process_latency[p] /= per_process[p];
+    }
+
+    result.makespan = now;
+    return result;
+}
+
+/**
+ * Disk I/O Request Scheduling Simulation
+ * Compares FIFO, LOOK, C-LOOK, Deadline and BFQ-like schedulers on one workload
+ * @param requests Storage workload
+ * @return Average request latency under the deadline scheduler
+ */
+double disk_io_scheduling(const std::vector<DiskRequest>& requests) {
+    std::vector<std::unique_ptr<DiskScheduler>> schedulers;
+    schedulers.emplace_back(new FifoDiskScheduler());
+    schedulers.emplace_back(new ElevatorDiskScheduler(false));
+    schedulers.emplace_back(new ElevatorDiskScheduler(true));
+    schedulers.emplace_back(new DeadlineDiskScheduler());
+    schedulers.emplace_back(new BfqDiskScheduler(std::vector<int>(DISK_PROCESSES, 1)));
+
+    std::cout << "\n" << std::string(84, '=') << std::endl;
+    std::cout << "DISK I/O REQUEST SCHEDULING (" << requests.size() << " requests, "
+              << DISK_CYLINDERS << " cylinders)" << std::endl;
+    std::cout << std::string(84, '=') << std::endl;
+    std::cout << "Processes 0-1: sequential readers, 2: random reader, 3: random writer" << std::endl;
+    std::cout << std::string(84, '-') << std::endl;
+    std::cout << std::setw(16) << std::left << "Scheduler" << std::right
+              << std::setw(9) << "Avg Lat" << std::setw(9) << "p95" << std::setw(9) << "p99"
+              << std::setw(8) << "IOPS" << std::setw(10) << "Seek/Req" << std::setw(9) << "Misses"
+              << std::setw(15) << "Proc Lat Range" << std::endl;
+    std::cout << std::string(84, '-') << std::endl;
+
+    double deadline_latency = 0;
+    for (const auto& scheduler : schedulers) {
+        DiskResult result = simulateDisk(requests, *scheduler);
+        LatencySummary latency = summarizeLatencies(result.latency);
+        auto range = std::minmax_element(result.process_latency.begin(), result.process_latency.end());
+        std::cout << std::setw(16) << std::left << scheduler->name() << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(9) << latency.mean << std::setw(9) << latency.p95 << std::setw(9) << latency.p99
+                  << std::setw(8) << std::setprecision(0) << 1000.0 * requests.size() / result.makespan
+                  << std::setw(10) << std::setprecision(1) << static_cast<double>(result.seek_cylinders) / requests.size()
+                  << std::setw(9) << result.read_deadline_misses
+                  << std::setw(8) << std::setprecision(1) << *range.first << "-" << std::setw(6) << std::left
+                  << *range.second << std::right << std::endl;
+        if (scheduler->name() == "Deadline") deadline_latency = latency.mean;
+    }
+    std::cout << std::string(84, '-') << std::endl;
+    std::cout << "Times in ms; Misses = reads slower than " << DEADLINE_READ_EXPIRE << " ms." << std::endl;
+    std::cout << std::string(84, '=') << std::endl;
+
+    return deadline_latency;
+}
+
+/**
+ * Fixed-memory latency histogram with log-linear buckets
+ * Each power of two is split into HISTOGRAM_SUB_BUCKETS linear buckets, so recording is
+ * O(1) and percentiles carry a bounded relative error, however many samples are taken
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() : buckets(HISTOGRAM_OCTAVES * HISTOGRAM_SUB_BUCKETS, 0) {}
+
+    void record(double value) {
+        total++;
+        sum += value;
+        largest = std::max(largest, value);
+        buckets[bucketIndex(value)]++;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < buckets.size(); i++) buckets[i] += other.buckets[i];
+        total += other.total;
+        sum += other.sum;
+        largest = std::max(largest, other.largest);
+    }
+
+    long count() const { return total; }
+    double mean() const { return total ? sum / total : 0; }
+    double max() const { return largest; }
+
+    // Upper bound of the bucket holding the p-th quantile (nearest rank)
+    double percentile(double p) const {
+        if (total == 0) return 0;
+        long rank = std::max(1L, static_cast<long>(std::ceil(p * total)));
+        long seen = 0;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            seen += buckets[i];
+            if (seen >= rank) return std::min(largest, bucketUpperBound(i));
+        }
+        return largest;
+    }
+
+    // Number of buckets and the upper bound of each, for exporting the distribution
+    size_t bucketCount() const { return buckets.size(); }
+    long bucketValue(size_t i) const { return buckets[i]; }
+    double bucketUpperBound(size_t i) const {
+        int exponent = static_cast<int>(i / HISTOGRAM_SUB_BUCKETS) + HISTOGRAM_MIN_EXPONENT;
+        double mantissa = 0.5 + 0.5 * (i % HISTOGRAM_SUB_BUCKETS + 1) / HISTOGRAM_SUB_BUCKETS;
+        return std::ldexp(mantissa, exponent);
+    }
+
+private:
+    static size_t bucketIndex(double value) {
+        if (value <= 0) return 0;
+        int exponent;
+        double mantissa = std::frexp(value, &exponent);   // value = mantissa * 2^exponent, mantissa in [0.5, 1)
+        int octave = exponent - HISTOGRAM_MIN_EXPONENT;
+        if (octave < 0) return 0;
+        if (octave >= HISTOGRAM_OCTAVES) return HISTOGRAM_OCTAVES * HISTOGRAM_SUB_BUCKETS - 1;
+        int sub = static_cast<int>((mantissa - 0.5) * 2 * HISTOGRAM_SUB_BUCKETS);
+        return octave * HISTOGRAM_SUB_BUCKETS + sub;
+    }
+
+    std::vector<long> buckets;
+    long total = 0;
+    double sum = 0;
+    double largest = 0;
+};
+
+/**
+ * Network flow offered to the link
+ */
+struct Flow {
+    int id;              // Flow ID
+    int priority;        // Strict-priority class (lower number = higher priority)
+    int weight;          // Share weight for DRR and WFQ
+    int packet_size;     // Mean packet size in bytes
+    double rate;         // Offered load in bytes per microsecond
+};
+
+/**
+ * Generates random flows whose combined offered load is PACKET_OFFERED_LOAD times the link rate
+ * Weights follow priority, like processes: priority 1 gets the largest weight
+ * @param num_flows Number of flows to generate
+ * @return Vector of randomly generated flows
+ */
+std::vector<Flow> generateFlows(int num_flows) {
+    std::vector<Flow> flows;
+    std::vector<double> shares;
+    double total_share = 0;
+    for (int i = 0; i < num_flows; i++) {
+        int priority = rand() % (MAX_PRIORITY - MIN_PRIORITY + 1) + MIN_PRIORITY;
+        int packet_size = PACKET_MIN_SIZE + rand() % (PACKET_MAX_SIZE - PACKET_MIN_SIZE + 1);
+        flows.push_back({i, priority, MAX_PRIORITY - priority + 1, packet_size, 0});
+        shares.push_back(1 + rand() % 4);
+        total_share += shares.back();
+    }
+    for (int i = 0; i < num_flows; i++) {
+        flows[i].rate = PACKET_OFFERED_LOAD * LINK_RATE * shares[i] / total_share;
+    }
+    return flows;
+}
+
+/**
+ * Packet waiting in a flow queue
+ */
+struct Packet {
+    double arrival_time;
+    double finish_tag;   // WFQ virtual finish time
+    int size;
+};
+
+/**
+ * Bounded FIFO of packets stored in a power-of-two ring buffer
+ */
+class PacketRing {
+public:
+    PacketRing() : slots(PACKET_QUEUE_LIMIT_POW2) {}
+    bool empty() const { return head == tail; }
+    bool full() const { return tail - head == PACKET_QUEUE_LIMIT; }
+    Packet& front() { return slots[head & (PACKET_QUEUE_LIMIT_POW2 - 1)]; }
+    Packet& back() { return slots[(tail - 1) & (PACKET_QUEUE_LIMIT_POW2 - 1)]; }
+    void push(const Packet& packet) { slots[tail++ & (PACKET_QUEUE_LIMIT_POW2 - 1)] = packet; }
+    void pop() { head++; }
+
+private:
+    std::vector<Packet> slots;
+    unsigned long head = 0;
+    unsigned long tail = 0;
+};
+
+/**
+ * Strict priority queueing discipline
+ * Always serves the highest non-empty priority class, round robin between its flows
+ */
+class StrictPriorityQdisc {
+public:
+    explicit StrictPriorityQdisc(const std::vector<Flow>& flows)
+        : flows(flows), classes(MAX_PRIORITY - MIN_PRIORITY + 1) {}
+
+    static const char* name() { return "Strict Priority"; }
+
+    void enqueue(int flow, PacketRing& queue, const Packet& packet) {
+        bool was_empty = queue.empty();
+        queue.push(packet);
+        if (was_empty) classes[flows[flow].priority - MIN_PRIORITY].push_back(flow);
+    }
+
+    int dequeueFlow(std::vector<PacketRing>& queues) {
+        (void)queues;
+        for (std::deque<int>& active : classes) {
+            if (active.empty()) continue;
+            // One packet per turn; the flow rejoins the back if it stays backlogged
+            int flow = active.front();
+            active.pop_front();
+            return flow;
+        }
+        return -1;
+    }
+
+    void afterDequeue(int flow, PacketRing& queue) {
+        if (!queue.empty()) classes[flows[flow].priority - MIN_PRIORITY].push_back(flow);
+    }
+
+private:
+    const std::vector<Flow>& flows;
+    std::vector<std::deque<int>> classes;
+};
+
+/**
+ * Deficit Round Robin queueing discipline
+ * Each backlogged flow earns weight * DRR_QUANTUM bytes of credit per round and sends
+ * head packets while its deficit covers them
+ */
+class DeficitRoundRobinQdisc {
+public:
+    explicit DeficitRoundRobinQdisc(const std::vector<Flow>& flows)
+        : flows(flows), deficit(flows.size(), 0) {}
+
+    static const char* name() { return "Deficit Round Robin"; }
+
+    void enqueue(int flow, PacketRing& queue, const Packet& packet) {
+        bool was_empty = queue.empty();
+        queue.push(packet);
+        if (was_empty) {
+            deficit[flow] = 0;
+            active.push_back(flow);
+        }
+    }
+
+    int dequeueFlow(std::vector<PacketRing>& queues) {
+        if (active.empty()) return -1;
+        while (true) {
+            int flow = active.front();
+            if (!in_turn) {
+                deficit[flow] += flows[flow].weight * DRR_QUANTUM;
+                in_turn = true;
+            }
+            if (deficit[flow] >= queues[flow].front().size) {
+                deficit[flow] -= queues[flow].front().size;
+                return flow;
+            }
+            // Not enough credit: keep the deficit and move to the next flow
+            active.pop_front();
+            active.push_back(flow);
+            in_turn = false;
+        }
+    }
+
+    void afterDequeue(int flow, PacketRing& queue) {
+        if (queue.empty()) {
+            deficit[flow] = 0;
+            active.pop_front();
+            in_turn = false;
+        }
+    }
+
+private:
+    const std::vector<Flow>& flows;
+    std::vector<long> deficit;
+    std::deque<int> active;
+    bool in_turn = false;
+};
+
+/**
+ * Weighted Fair Queueing discipline (self-clocked virtual time)
+ * Every packet is stamped with a virtual finish time at arrival; head-of-line packets of
+ * the backlogged flows sit in a min-heap and the smallest finish time is sent next
+ */
+class WeightedFairQueueingQdisc {
+public:
+    explicit WeightedFairQueueingQdisc(const std::vector<Flow>& flows)
+        : flows(flows), last_finish(flows.size(), 0) {}
+
+    static const char* name() { return "Weighted Fair Queueing"; }
+
+    void enqueue(int flow, PacketRing& queue, const Packet& packet) {
+        bool was_empty = queue.empty();
+        queue.push(packet);
+        double start = std::max(virtual_time, last_finish[flow]);
+        last_finish[flow] = start + static_cast<double>(packet.size) / flows[flow].weight;
+        queue.back().finish_tag = last_finish[flow];
+        if (was_empty) heap.push(std::make_pair(last_finish[flow], flow));
+    }
+
+    int dequeueFlow(std::vector<PacketRing>& queues) {
+        (void)queues;
+        if (heap.empty()) return -1;
+        int flow = heap.top().second;
+        virtual_time = heap.top().first;
+        heap.pop();
+        return flow;
+    }
+
+    void afterDequeue(int flow, PacketRing& queue) {
+        if (!queue.empty()) heap.push(std::make_pair(queue.front().finish_tag, flow));
+    }
+
+private:
+    typedef std::pair<double, int> Tag;
+    const std::vector<Flow>& flows;
+    std::vector<double> last_finish;
+    double virtual_time = 0;
+    std::priority_queue<Tag, std::vector<Tag>, std::greater<Tag>> heap;
+};
+
+/**
+ * Per-flow results of a link simulation
+ */
+struct PacketResult {
+    std::vector<LatencyHistogram> delay;   // Queueing plus transmission delay per flow
+    std::vector<long> bytes_sent;
+    std::vector<long> drops;               // Tail drops at a full flow queue
+    double duration = 0;                   // Simulated microseconds
+    double wall_seconds = 0;               // Real time spent simulating
+};
+
+/**
+ * Simulates one output link fed by Poisson flows through a queueing discipline
+ * Arrivals are generated lazily per flow, so memory stays constant for any packet count
+ * @param flows Offered flows
+ * @param qdisc Queueing discipline (StrictPriorityQdisc, DeficitRoundRobinQdisc or WeightedFairQueueingQdisc)
+ * @param num_packets Packets to generate across all flows
+ * @param seed Random seed (share it across disciplines to compare on identical traffic)
+ * @return Per-flow delays, throughput and drops
+ */
+template <class Qdisc>
+PacketResult simulateLink(const std::vector<Flow>& flows, Qdisc& qdisc, long num_packets, unsigned seed) {
+    int F = flows.size();
+    PacketResult result;
+    result.delay.resize(F);
+    result.bytes_sent.assign(F, 0);
+    result.drops.assign(F, 0);
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<PacketRing> queues(F);
+
+    // Next arrival of every flow, earliest first
+    typedef std::pair<double, int> Arrival;
+    std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>> arrivals;
+    auto next_gap = [&](int f) {
+        return -std::log(1.0 - uniform(rng)) * flows[f].packet_size / flows[f].rate;
+    };
+    for (int f = 0; f < F; f++) {
+        arrivals.push(std::make_pair(next_gap(f), f));
+    }
+
+    auto wall_start = std::chrono::steady_clock::now();
+    long generated = 0;
+    double link_free = 0;
+    int in_service = -1;
+    Packet sending = {0, 0, 0};
+    while (generated < num_packets || in_service != -1) {
+        double arrival_time = generated < num_packets ? arrivals.top().first : std::numeric_limits<double>::max();
+
+        if (in_service != -1 && link_free <= arrival_time) {
+            // Transmission finished
+            result.delay[in_service].record(link_free - sending.arrival_time);
+            result.bytes_sent[in_service] += sending.size;
+            in_service = -1;
+        } else {
+            int f = arrivals.top().second;
+            arrivals.pop();
+            arrivals.push(std::make_pair(arrival_time + next_gap(f), f));
+            generated++;
+            if (queues[f].full()) {
+                result.drops[f]++;
+            } else {
+                // Sizes vary +/-50% around the flow's mean
+                int size = static_cast<int>(flows[f].packet_size * (0.5 + uniform(rng)));
+                qdisc.enqueue(f, queues[f], Packet{arrival_time, 0, size});
+            }
+            if (in_service == -1) link_free = arrival_time;
+        }
+
+        if (in_service == -1) {
+            int f = qdisc.dequeueFlow(queues);
+            if (f != -1) {
+                sending = queues[f].front();
+                queues[f].pop();
+                qdisc.afterDequeue(f, queues[f]);
+                in_service = f;
+                link_free += sending.size / LINK_RATE;
+            }
+        }
+    }
+
+    result.duration = link_free;
+    result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    return result;
+}
+
+/**
+ * Prints per-flow throughput, delay percentiles and drops for one discipline
+ */
+void displayPacketResult(const char* name, const std::vector<Flow>& flows, const PacketResult& result, long num_packets) {
+    std::cout << "\n" << name << "  (" << std::fixed << std::setprecision(2)
+              << num_packets / result.wall_seconds / 1e6 << " M packets/s simulated)" << std::endl;
+    std::cout << std::string(78, '-') << std::endl;
+    std::cout << std::setw(5) << "Flow" << std::setw(6) << "Prio" << std::setw(8) << "Weight"
+              << std::setw(10) << "Offered" << std::setw(10) << "Through" << std::setw(10) << "Mean us"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(9) << "Drop%" << std::endl;
+    for (size_t f = 0; f < flows.size(); f++) {
+        const LatencyHistogram& delay = result.delay[f];
+        long offered_packets = delay.count() + result.drops[f];
+        std::cout << std::setw(5) << flows[f].id << std::setw(6) << flows[f].priority << std::setw(8) << flows[f].weight
+                  << std::setw(9) << 100 * flows[f].rate / LINK_RATE << "%"
+                  << std::setw(9) << 100 * result.bytes_sent[f] / (result.duration * LINK_RATE) << "%"
+                  << std::setw(10) << delay.mean() << std::setw(10) << delay.percentile(0.50)
+                  << std::setw(10) << delay.percentile(0.99)
+                  << std::setw(8) << (offered_packets ? 100.0 * result.drops[f] / offered_packets : 0) << "%" << std::endl;
+    }
+}
+
+/**
+ * Network Packet Scheduling Simulation
+ * Runs identical traffic through strict priority, DRR and WFQ on one output link
+ * @param flows Offered flows
+ * @param num_packets Packets to simulate per discipline
+ * @return Mean packet delay under WFQ
+ */
+double packet_scheduling(const std::vector<Flow>& flows, long num_packets) {
+    unsigned seed = rand();
+
+    std::cout << "\n" << std::string(78, '=') << std::endl;
+    std::cout << "NETWORK PACKET SCHEDULING (" << LINK_RATE * 8 / 1000 << " Gbit/s link, "
+              << num_packets << " packets, offered load " << PACKET_OFFERED_LOAD * 100 << "%)" << std::endl;
+    std::cout << std::string(78, '=') << std::endl;
+
+    StrictPriorityQdisc priority(flows);
+    displayPacketResult(StrictPriorityQdisc::name(), flows, simulateLink(flows, priority, num_packets, seed), num_packets);
+
+    DeficitRoundRobinQdisc drr(flows);
+    displayPacketResult(DeficitRoundRobinQdisc::name(), flows, simulateLink(flows, drr, num_packets, seed), num_packets);
+
+    WeightedFairQueueingQdisc wfq(flows);
+    PacketResult wfq_result = simulateLink(flows, wfq, num_packets, seed);
+    displayPacketResult(WeightedFairQueueingQdisc::name(), flows, wfq_result, num_packets);
+    std::cout << std::string(78, '=') << std::endl;
+
+    LatencyHistogram overall;
+    for (const LatencyHistogram& delay : wfq_result.delay) overall.merge(delay);
+    return overall.mean();
+}
+
+/**
+ * Memory behaviour of a process for the paging model
+ */
+struct MemoryProfile {
+    int working_set;   // Pages referenced most of the time
+    int footprint;     // Total pages the process may touch
+};
+
+/**
+ * Generates a random memory profile for every process
+ * @param processes Processes needing a profile
+ * @return One profile per process, in the same order
+ */
+std::vector<MemoryProfile> generateMemoryProfiles(const std::vector<Process>& processes) {
+    std::vector<MemoryProfile> profiles;
+    for (size_t i = 0; i < processes.size(); i++) {
+        int working_set = rand() % (MAX_WORKING_SET - MIN_WORKING_SET + 1) + MIN_WORKING_SET;
+        profiles.push_back({working_set, working_set * FOOTPRINT_FACTOR});
+    }
+    return profiles;
+}
+
+/**
+ * Page replacement algorithms for the global frame pool
+ */
+enum ReplacementPolicy {
+    REPLACE_CLOCK,   // Second chance: sweep a hand, clearing reference bits
+    REPLACE_LRU      // Evict the least recently used frame
+};
+
+/**
+ * Results of a paging simulation run
+ */
+struct PagingResult {
+    std::vector<double> turnaround_time;
+    long useful_ticks = 0;   // Ticks spent executing instructions
+    long page_faults = 0;
+    int makespan = 0;
+};
+
+/**
+ * Simulates a single CPU with demand paging over a fixed pool of frames
+ * Every tick a running process references one page, from its working set with
+ * probability PAGE_LOCALITY and from its whole footprint otherwise. A miss blocks the
+ * process like I/O until a single paging device has loaded the page.
+ * @param processes Processes to run (all arrive at time 0)
+ * @param profiles Memory profile of each process
+ * @param kind Ready queue policy
+ * @param replacement Page replacement algorithm
+ * @param seed Seed for the reference string (share it to compare policies)
+ * @return Turnaround times and paging counters
+ */
+PagingResult simulate_paging(const std::vector<Process>& processes, const std::vector<MemoryProfile>& profiles,
+                             PolicyKind kind, ReplacementPolicy replacement, unsigned seed) {
+    int N = processes.size();
+    PagingResult result;
+    result.turnaround_time.assign(N, 0);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    struct Frame {
+        int process = -1;
+        int page = -1;
+        bool referenced = false;
+        long last_used = 0;
+    };
+    std::vector<Frame> frames(PAGE_FRAMES);
+    std::vector<std::vector<int>> page_table(N);   // Page -> frame, -1 if not resident
+    std::vector<long> remaining(N);
+    std::unique_ptr<SchedulerPolicy> policy = makePolicy(kind);
+    for (int i = 0; i < N; i++) {
+        page_table[i].assign(profiles[i].footprint, -1);
+        remaining[i] = static_cast<long>(processes[i].burst_time) * PAGING_TICKS_PER_BURST;
+        policy->enqueue(ReadyProcess{i, processes[i].pid, processes[i].priority, processes[i].burst_time,
+                                     processes[i].arrival_time, static_cast<double>(remaining[i])}, 0);
+    }
+
+    int clock_hand = 0;
+    auto victim = [&]() {
+        for (int f = 0; f < PAGE_FRAMES; f++) {
+            if (frames[f].process == -1) return f;
+        }
+        if (replacement == REPLACE_CLOCK) {
+            while (frames[clock_hand].referenced) {
+                frames[clock_hand].referenced = false;
+                clock_hand = (clock_hand + 1) % PAGE_FRAMES;
+            }
+            int f = clock_hand;
+            clock_hand = (clock_hand + 1) % PAGE_FRAMES;
+            return f;
+        }
+        int oldest = 0;
+        for (int f = 1; f < PAGE_FRAMES; f++) {
+            if (frames[f].last_used < frames[oldest].last_used) oldest = f;
+        }
+        return oldest;
+    };
+
+    std::deque<std::pair<int, int>> device_queue;   // (process, page) waiting for the paging device
+    long device_done = -1;
+    int current = -1;
+    long slice_left = 0;
+    long time = 0;
+    int completed = 0;
+    while (completed < N) {
+        if (current == -1 && !policy->empty()) {
+            current = policy->pickNext(time);
+            double slice = policy->timeSlice(current, time);
+            slice_left = slice > 0 ? static_cast<long>(slice * PAGING_TICKS_PER_BURST) : std::numeric_limits<long>::max();
+        }
+
+        if (current != -1) {
+            const MemoryProfile& profile = profiles[current];
+            int page = uniform(rng) < PAGE_LOCALITY ? static_cast<int>(uniform(rng) * profile.working_set)
+                                                    : static_cast<int>(uniform(rng) * profile.footprint);
+            int frame = page_table[current][page];
+            if (frame == -1) {
+                result.page_faults++;
+                device_queue.push_back(std::make_pair(current, page));
+                current = -1;
+            } else {
+                frames[frame].referenced = true;
+                frames[frame].last_used = time;
+                result.useful_ticks++;
+                slice_left--;
+                if (--remaining[current] == 0) {
+                    for (int& f : page_table[current]) {
+                        if (f != -1) frames[f] = Frame();
+                        f = -1;
+                    }
+                    result.turnaround_time[current] = time + 1;
+                    policy->onComplete(current, time + 1);
+                    completed++;
+                    current = -1;
+                } else if (slice_left <= 0 && !policy->empty()) {
+                    const Process& p = processes[current];
+                    policy->enqueue(ReadyProcess{current, p.pid, p.priority, p.burst_time, p.arrival_time,
+                                                 static_cast<double>(remaining[current])}, time + 1);
+                    current = -1;
+                }
+            }
+        }
+        time++;
+
+        // The paging device loads one page at a time
+        if (device_done == -1 && !device_queue.empty()) {
+            device_done = time + PAGE_FAULT_SERVICE;
+        }
+        if (device_done != -1 && time >= device_done) {
+            int process = device_queue.front().first;
+            int page = device_queue.front().second;
+            device_queue.pop_front();
+            int f = victim();
+            if (frames[f].process != -1) page_table[frames[f].process][frames[f].page] = -1;
+            frames[f].process = process;
+            frames[f].page = page;
+            frames[f].referenced = true;
+            frames[f].last_used = time;
+            page_table[process][page] = f;
+            const Process& p = processes[process];
+            policy->enqueue(ReadyProcess{process, p.pid, p.priority, p.burst_time, p.arrival_time,
+                                         static_cast<double>(remaining[process])}, time);
+            device_done = device_queue.empty() ? -1 : time + PAGE_FAULT_SERVICE;
+        }
+    }
+
+    result.makespan = time;
+    return result;
+}
+
+/**
+ * Paging and Thrashing Simulation
+ * Raises the multiprogramming level over a fixed frame pool and reports CPU utilization
+ * and page faults for each scheduler and replacement algorithm
+ * @param processes Workload; prefixes of increasing length are admitted
+ * @param profiles Memory profile of each process
+ * @return CPU utilization (0-1) of Round Robin with CLOCK at the highest level
+ */
+double paging_simulation(const std::vector<Process>& processes, const std::vector<MemoryProfile>& profiles) {
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    const ReplacementPolicy replacements[] = {REPLACE_CLOCK, REPLACE_LRU};
+    unsigned seed = rand();
+    double last_utilization = 0;
+
+    std::cout << "\n" << std::string(78, '=') << std::endl;
+    std::cout << "PAGING AND THRASHING (" << PAGE_FRAMES << " frames, fault service = "
+              << PAGE_FAULT_SERVICE << " ticks)" << std::endl;
+    std::cout << std::string(78, '=') << std::endl;
+
+    for (ReplacementPolicy replacement : replacements) {
+        std::cout << "\n" << (replacement == REPLACE_CLOCK ? "CLOCK" : "LRU")
+                  << " replacement: CPU utilization % / page faults" << std::endl;
+        std::cout << std::string(78, '-') << std::endl;
+        std::cout << std::setw(5) << "MPL" << std::setw(9) << "WS/Mem";
+        for (PolicyKind kind : kinds) std::cout << std::setw(16) << policyKindName(kind);
+        std::cout << std::endl;
+
+        for (size_t level = PAGING_MPL_STEP; level <= processes.size(); level += PAGING_MPL_STEP) {
+            std::vector<Process> admitted(processes.begin(), processes.begin() + level);
+            std::vector<MemoryProfile> admitted_profiles(profiles.begin(), profiles.begin() + level);
+            int working_sets = 0;
+            for (const MemoryProfile& profile : admitted_profiles) working_sets += profile.working_set;
+
+            std::cout << std::setw(5) << level << std::setw(8) << std::fixed << std::setprecision(2)
+                      << static_cast<double>(working_sets) / PAGE_FRAMES << "x";
+            for (PolicyKind kind : kinds) {
+                PagingResult result = simulate_paging(admitted, admitted_profiles, kind, replacement, seed);
+                double utilization = static_cast<double>(result.useful_ticks) / result.makespan;
+                std::ostringstream cell;
+                cell << std::fixed << std::setprecision(1) << 100 * utilization << "% / " << result.page_faults;
+                std::cout << std::setw(16) << cell.str();
+                if (kind == POLICY_RR && replacement == REPLACE_CLOCK) last_utilization = utilization;
+            }
+            std::cout << std::endl;
+        }
+    }
+    std::cout << std::string(78, '-') << std::endl;
+    std::cout << "MPL = processes in memory; WS/Mem = total working sets over available frames." << std::endl;
+    std::cout << "Utilization collapsing as WS/Mem passes 1 is thrashing." << std::endl;
+    std::cout << std::string(78, '=') << std::endl;
+
+    return last_utilization;
+}
+
+/**
+ * Rejects arrivals while the ready queue is at its cap
+ */
+class QueueCapAdmission : public AdmissionController {
+public:
+    explicit QueueCapAdmission(int cap) : cap(cap) {}
+    std::string name() const override { return "Queue Cap"; }
+    bool admit(const Process& process, double now, int queue_length, double backlog) override {
+        (void)process; (void)now; (void)backlog;
+        return queue_length < cap;
+    }
+
+private:
+    int cap;
+};
+
+/**
+ * Token bucket rate limiter: each admission costs one token
+ */
+class TokenBucketAdmission : public AdmissionController {
+public:
+    TokenBucketAdmission(double rate, double bucket_size) : rate(rate), bucket_size(bucket_size), tokens(bucket_size) {}
+    std::string name() const override { return "Token Bucket"; }
+    bool admit(const Process& process, double now, int queue_length, double backlog) override {
+        (void)process; (void)queue_length; (void)backlog;
+        tokens = std::min(bucket_size, tokens + (now - last_refill) * rate);
+        last_refill = now;
+        if (tokens < 1) return false;
+        tokens -= 1;
+        return true;
+    }
+
+private:
+    double rate;
+    double bucket_size;
+    double tokens;
+    double last_refill = 0;
+};
+
+/**
+ * Rejects arrivals that could not finish within the latency objective even if
+ * served after the work already admitted
+ */
+class DeadlineAdmission : public AdmissionController {
+public:
+    explicit DeadlineAdmission(double objective) : objective(objective) {}
+    std::string name() const override { return "Deadline-Aware"; }
+    bool admit(const Process& process, double now, int queue_length, double backlog) override {
+        (void)now; (void)queue_length;
+        return backlog + process.burst_time <= objective;
+    }
+
+private:
+    double objective;
+};
+
+/**
+ * CoDel-style shedding on queueing delay
+ * Once the sojourn time of processes leaving the queue has stayed above the target for a
+ * whole interval, processes are shed at intervals shrinking with 1/sqrt(drops) until the
+ * sojourn time falls below the target again
+ */
+class CoDelAdmission : public AdmissionController {
+public:
+    CoDelAdmission(double target, double interval) : target(target), interval(interval) {}
+    std::string name() const override { return "CoDel"; }
+    bool admit(const Process& process, double now, int queue_length, double backlog) override {
+        (void)process; (void)now; (void)queue_length; (void)backlog;
+        return true;
+    }
+
+    bool shed(const Process& process, double sojourn, double now) override {
+        (void)process;
+        if (sojourn < target) {
+            first_above = -1;
+            dropping = false;
+            return false;
+        }
+        if (dropping) {
+            if (now < drop_next) return false;
+            count++;
+            drop_next += interval / std::sqrt(static_cast<double>(count));
+            return true;
+        }
+        if (first_above < 0) {
+            first_above = now + interval;
+            return false;
+        }
+        if (now < first_above) return false;
+        dropping = true;
+        // Resume near the previous drop rate if the last dropping episode was recent
+        count = (count > 2 && now - drop_next < 16 * interval) ? count - 2 : 1;
+        drop_next = now + interval / std::sqrt(static_cast<double>(count));
+        return true;
+    }
+
+private:
+    double target;
+    double interval;
+    double first_above = -1;
+    double drop_next = 0;
+    bool dropping = false;
+    int count = 0;
+};
+
+/**
+ * Admission Control and Overload Shedding
+ * Sweeps offered load and reports goodput for each overload policy in front of a scheduler
+ * @param kind Scheduler behind the admission policies
+ * @return Goodput (fraction of CPU capacity) of deadline-aware rejection at the highest load
+ */
+double admission_control(PolicyKind kind) {
+    const double loads[] = {0.5, 0.8, 0.95, 1.1, 1.5, 2.0};
+    const char* names[] = {"None", "Queue Cap", "Token Bucket", "Deadline-Aware", "CoDel"};
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    unsigned seed = rand();
+    double last_goodput = 0;
+
+    std::cout << "\n" << std::string(82, '=') << std::endl;
+    std::cout << "ADMISSION CONTROL (" << policyKindName(kind) << ", latency objective = "
+              << ADMISSION_LATENCY_OBJECTIVE << ")" << std::endl;
+    std::cout << std::string(82, '=') << std::endl;
+    std::cout << "Goodput = CPU share spent on processes finishing within the objective (rejected %)" << std::endl;
+    std::cout << std::string(82, '-') << std::endl;
+    std::cout << std::setw(7) << "Load";
+    for (const char* name : names) std::cout << std::setw(15) << name;
+    std::cout << std::endl;
+    std::cout << std::string(82, '-') << std::endl;
+
+    for (double load : loads) {
+        std::vector<Process> workload = generateArrivalWorkload(ADMISSION_PROCESS_COUNT, load / mean_burst, seed);
+        std::cout << std::setw(6) << std::fixed << std::setprecision(2) << load << "x";
+        for (int a = 0; a < 5; a++) {
+            std::unique_ptr<AdmissionController> controller;
+            if (a == 1) controller.reset(new QueueCapAdmission(ADMISSION_QUEUE_CAP));
+            else if (a == 2) controller.reset(new TokenBucketAdmission(ADMISSION_TOKEN_RATE / mean_burst, ADMISSION_TOKEN_BUCKET));
+            else if (a == 3) controller.reset(new DeadlineAdmission(ADMISSION_LATENCY_OBJECTIVE));
+            else if (a == 4) controller.reset(new CoDelAdmission(ADMISSION_CODEL_TARGET, ADMISSION_CODEL_INTERVAL));
+
+            std::unique_ptr<SchedulerPolicy> policy = makePolicy(kind);
+            EngineOptions options;
+            options.admission = controller.get();
+            EngineResult result = simulateWorkload(workload, *policy, options);
+
+            double good_work = 0;
+            for (size_t i = 0; i < workload.size(); i++) {
+                if (!result.dropped[i] && result.turnaround_time[i] <= ADMISSION_LATENCY_OBJECTIVE) {
+                    good_work += workload[i].burst_time;
+                }
+            }
+            double goodput = good_work / result.makespan;
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(1) << 100 * goodput << "% ("
+                 << 100.0 * result.dropped_count / workload.size() << ")";
+            std::cout << std::setw(15) << cell.str();
+            if (a == 3) last_goodput = goodput;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(82, '=') << std::endl;
+
+    return last_goodput;
+}
+
+/**
+ * Tickless versus Periodic-Tick Timer Modeling
+ * Runs Round Robin on one arrival workload under several timer models and reports the
+ * latency and CPU overhead each one causes
+ * @param quantum Round Robin time quantum
+ * @return Average waiting time under tickless timers
+ */
+double timer_modeling(double quantum) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    std::vector<Process> workload = generateArrivalWorkload(TIMER_PROCESS_COUNT, TIMER_OFFERED_LOAD / mean_burst, rand());
+
+    std::vector<std::pair<std::string, TimerModel>> modes;
+    TimerModel timer;
+    modes.push_back(std::make_pair("Ideal (instant)", timer));
+    const int hz_values[] = {100, 250, 1000};
+    for (int hz : hz_values) {
+        timer.mode = TIMER_PERIODIC;
+        timer.hz = hz;
+        modes.push_back(std::make_pair("Periodic HZ=" + std::to_string(hz), timer));
+    }
+    timer.mode = TIMER_TICKLESS;
+    modes.push_back(std::make_pair("Tickless (hrtimer)", timer));
+
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "TIMER MODELING (Round Robin, Quantum = " << quantum << " ms, load = "
+              << TIMER_OFFERED_LOAD * 100 << "%)" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(20) << std::left << "Timer" << std::right
+              << std::setw(9) << "Avg WT" << std::setw(10) << "p99 Resp" << std::setw(11) << "Avg Slice"
+              << std::setw(12) << "Timer IRQs" << std::setw(10) << "IRQ/s" << std::setw(10) << "Overhead" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    double tickless_wait = 0;
+    for (const auto& mode : modes) {
+        QueuePolicy policy(POLICY_RR, quantum);
+        EngineOptions options;
+        options.timer = mode.second;
+        EngineResult result = simulateWorkload(workload, policy, options);
+        LatencySummary response = summarizeLatencies(result.response_time);
+        double wait = result.averageWaitingTime();
+        std::cout << std::setw(20) << std::left << mode.first << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << wait << std::setw(10) << response.p99
+                  << std::setw(11) << result.busy_time / result.dispatches
+                  << std::setw(12) << result.timer_interrupts
+                  << std::setw(10) << std::setprecision(0) << 1000.0 * result.timer_interrupts / result.makespan
+                  << std::setw(9) << std::setprecision(3) << 100 * result.timer_overhead / result.makespan << "%" << std::endl;
+        if (mode.second.mode == TIMER_TICKLESS) tickless_wait = wait;
+    }
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << "Periodic ticks round each quantum up to a tick boundary and keep firing while idle;" << std::endl;
+    std::cout << "tickless mode pays a small cost to arm a one-shot timer per slice instead." << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+
+    return tickless_wait;
+}
+
+/**
+ * Coroutine handle for a green thread run by the executor
+ * The task starts suspended and suspends again at each preemption point it reaches after its slice ends
+ */
+class GreenTask {
+public:
+    struct promise_type {
+        GreenTask get_return_object() {
+            return GreenTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    GreenTask() {}
+    GreenTask(GreenTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    GreenTask& operator=(GreenTask&& other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    GreenTask(const GreenTask&) = delete;
+    GreenTask& operator=(const GreenTask&) = delete;
+    ~GreenTask() {
+        if (handle) handle.destroy();
+    }
+
+    // Runs the task until it yields or finishes; returns true once it has finished
+    bool resume() {
+        handle.resume();
+        return handle.done();
+    }
+
+private:
+    explicit GreenTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * State shared between the executor and a running green thread
+ */
+struct GreenTaskContext {
+    std::chrono::steady_clock::time_point deadline;   // End of the current time slice
+    long total_iterations = 0;                        // Work the kernel has to do
+    long done_iterations = 0;                         // Work completed so far
+    double checksum = 0;                              // Kernel result, kept so the work is not optimized away
+};
+
+/**
+ * Cooperative preemption point: suspends the task only if its time slice has ended
+ */
+struct PreemptionPoint {
+    const GreenTaskContext& context;
+    bool await_ready() const noexcept { return std::chrono::steady_clock::now() < context.deadline; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    void await_resume() const noexcept {}
+};
+
+/**
+ * One step of the synthetic CPU-bound kernel (a serial floating-point dependency chain)
+ */
+inline double spinStep(double x) {
+    return x * 1.0000001 + 1e-9;
+}
+
+/**
+ * Synthetic CPU-bound process: spins through its iterations, offering to yield every chunk
+ * @param context Executor state for this task
+ * @return Coroutine running the kernel
+ */
+GreenTask spinKernel(GreenTaskContext& context) {
+    double x = 1.0;
+    while (context.done_iterations < context.total_iterations) {
+        long chunk = std::min(EXECUTOR_CHUNK, context.total_iterations - context.done_iterations);
+        for (long i = 0; i < chunk; i++) {
+            x = spinStep(x);
+        }
+        context.done_iterations += chunk;
+        co_await PreemptionPoint{context};
+    }
+    context.checksum = x;
+}
+
+/**
+ * Measures how many kernel iterations this machine executes per unit of burst time
+ * @return Iterations per EXECUTOR_TIME_UNIT_MS of wall-clock time
+ */
+long calibrateSpinRate() {
+    const long sample = 2000000;
+    double best = 0;
+    double x = 1.0;
+    for (int round = 0; round < 3; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < sample; i++) {
+            x = spinStep(x);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, sample / elapsed.count());
+    }
+    volatile double sink = x;
+    (void)sink;
+    return std::max(1L, static_cast<long>(best * EXECUTOR_TIME_UNIT_MS));
+}
+
+/**
+ * Wall-clock results of running a workload on the green-thread executor (in burst-time units)
+ */
+struct ExecutorResult {
+    std::vector<double> waiting_time;
+    std::vector<double> turnaround_time;
+    long dispatches = 0;
+    double makespan = 0;
+};
+
+/**
+ * Runs every process as a real spin kernel on green threads multiplexed over worker threads
+ * The same policy object used by the simulation engine decides dispatch order and time slices;
+ * tasks yield cooperatively at the first preemption point after their slice ends
+ * @param processes Vector of processes to run (burst_time becomes real CPU work)
+ * @param policy Scheduling policy (accessed under the executor lock)
+ * @param workers Number of worker threads
+ * @param iterations_per_unit Kernel iterations per unit of burst time
+ * @return Measured waiting and turnaround times
+ */
+ExecutorResult run_green_threads(const std::vector<Process>& processes, SchedulerPolicy& policy,
+                                 int workers, long iterations_per_unit) {
+    typedef std::chrono::steady_clock Clock;
+    int N = processes.size();
+    ExecutorResult result;
+    result.waiting_time.assign(N, 0);
+    result.turnaround_time.assign(N, 0);
+
+    std::vector<GreenTaskContext> contexts(N);
+    std::vector<GreenTask> tasks(N);
+    std::vector<double> cpu_time(N, 0);
+    for (int i = 0; i < N; i++) {
+        contexts[i].total_iterations = processes[i].burst_time * iterations_per_unit;
+        tasks[i] = spinKernel(contexts[i]);
+    }
+    std::vector<int> arrival_order(N);
+    for (int i = 0; i < N; i++) arrival_order[i] = i;
+    std::stable_sort(arrival_order.begin(), arrival_order.end(),
+        [&](int a, int b) { return processes[a].arrival_time < processes[b].arrival_time; });
+
+    std::mutex lock;
+    std::condition_variable ready;
+    size_t next_arrival = 0;
+    int completed = 0;
+    const Clock::time_point start = Clock::now();
+    auto units = [&](Clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(t - start).count() / EXECUTOR_TIME_UNIT_MS;
+    };
+    auto snapshot = [&](int i) {
+        double remaining = processes[i].burst_time *
+            (1.0 - static_cast<double>(contexts[i].done_iterations) / std::max(1L, contexts[i].total_iterations));
+        return ReadyProcess{i, processes[i].pid, processes[i].priority, processes[i].burst_time,
+                            processes[i].arrival_time, remaining};
+    };
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> guard(lock);
+        while (completed < N) {
+            double now = units(Clock::now());
+            while (next_arrival < arrival_order.size() && processes[arrival_order[next_arrival]].arrival_time <= now) {
+                policy.enqueue(snapshot(arrival_order[next_arrival]), now);
+                next_arrival++;
+            }
+            int p = policy.empty() ? -1 : policy.pickNext(now);
+            if (p == -1) {
+                if (next_arrival < arrival_order.size()) {
+                    double wake = processes[arrival_order[next_arrival]].arrival_time * EXECUTOR_TIME_UNIT_MS;
+                    ready.wait_until(guard, start + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double, std::milli>(wake)));
+                } else {
+                    ready.wait(guard);   // Running tasks may be re-queued or finish
+                }
+                continue;
+            }
+            double slice = policy.timeSlice(p, now);
+            result.dispatches++;
+            guard.unlock();
+
+            Clock::time_point dispatched = Clock::now();
+            contexts[p].deadline = slice > 0
+                ? dispatched + std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<double, std::milli>(slice * EXECUTOR_TIME_UNIT_MS))
+                : Clock::time_point::max();
+            bool finished = tasks[p].resume();
+            Clock::time_point stopped = Clock::now();
+
+            guard.lock();
+            double ran = units(stopped) - units(dispatched);
+            cpu_time[p] += ran;
+            now = units(stopped);
+            policy.onTick(p, ran, now);
+            if (finished) {
+                policy.onComplete(p, now);
+                result.turnaround_time[p] = now - processes[p].arrival_time;
+                result.waiting_time[p] = result.turnaround_time[p] - cpu_time[p];
+                completed++;
+            } else {
+                policy.enqueue(snapshot(p), now);
+            }
+            result.makespan = std::max(result.makespan, now);
+            ready.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < workers; w++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return result;
+}
+
+/**
+ * Green-Thread Executor
+ * Runs the workload as real CPU-bound coroutines under FCFS, SJF, Priority and Round Robin
+ * and compares measured wall-clock times against the simulation engine
+ * @param processes Vector of processes to run
+ * @return Largest relative error of the single-worker average turnaround time against the simulation
+ */
+double green_thread_execution(const std::vector<Process>& processes) {
+    long iterations_per_unit = calibrateSpinRate();
+    int workers = std::max(1, std::min(EXECUTOR_MAX_WORKERS, static_cast<int>(std::thread::hardware_concurrency())));
+
+    std::cout << "\n" << std::string(82, '=') << std::endl;
+    std::cout << "GREEN-THREAD EXECUTOR (1 time unit = " << EXECUTOR_TIME_UNIT_MS << " ms, Quantum = " << QUANTUM << ")" << std::endl;
+    std::cout << std::string(82, '=') << std::endl;
+    std::cout << "Processes: " << processes.size() << ", spin kernel calibrated to "
+              << iterations_per_unit << " iterations per time unit" << std::endl;
+    std::cout << "Real times are wall-clock; the single-worker run is compared with the simulation" << std::endl;
+    std::cout << std::string(82, '-') << std::endl;
+    std::cout << std::setw(13) << std::left << "Policy" << std::right
+              << std::setw(9) << "Sim WT" << std::setw(9) << "Real WT"
+              << std::setw(9) << "Sim TAT" << std::setw(10) << "Real TAT" << std::setw(8) << "Error"
+              << std::setw(7) << "Disp" << std::setw(17) << ("TAT " + std::to_string(workers) + " worker(s)") << std::endl;
+    std::cout << std::string(82, '-') << std::endl;
+
+    double worst_error = 0;
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    for (PolicyKind kind : kinds) {
+        EngineResult simulated = simulateWorkload(processes, *makePolicy(kind));
+        ExecutorResult real = run_green_threads(processes, *makePolicy(kind), 1, iterations_per_unit);
+        ExecutorResult parallel = run_green_threads(processes, *makePolicy(kind), workers, iterations_per_unit);
+
+        LatencySummary sim_wait = summarizeLatencies(simulated.waiting_time);
+        LatencySummary sim_turnaround = summarizeLatencies(simulated.turnaround_time);
+        LatencySummary real_wait = summarizeLatencies(real.waiting_time);
+        LatencySummary real_turnaround = summarizeLatencies(real.turnaround_time);
+        LatencySummary parallel_turnaround = summarizeLatencies(parallel.turnaround_time);
+        double error = sim_turnaround.mean > 0
+            ? std::fabs(real_turnaround.mean - sim_turnaround.mean) / sim_turnaround.mean : 0;
+        worst_error = std::max(worst_error, error);
+
+        std::cout << std::setw(13) << std::left << policyKindName(kind) << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(9) << sim_wait.mean << std::setw(9) << real_wait.mean
+                  << std::setw(9) << sim_turnaround.mean << std::setw(10) << real_turnaround.mean
+                  << std::setw(7) << 100.0 * error << "%"
+                  << std::setw(7) << real.dispatches << std::setw(17) << parallel_turnaround.mean << std::endl;
+    }
+    std::cout << std::string(82, '-') << std::endl;
+    std::cout << "Error: relative difference of real vs simulated average turnaround (1 worker)" << std::endl;
+    std::cout << std::string(82, '=') << std::endl;
+
+    return worst_error;
+}
+
+/**
+ * Free-list allocator for coroutine frames
+ * Frames are rounded up to FRAME_POOL_GRANULE-byte size classes and recycled instead of freed.
+ * Not thread-safe: behavioral workloads run on the single-threaded engine
+ */
+class FramePool {
+public:
+    ~FramePool() {
+        for (FreeFrame*& head : free_lists) {
+            while (head) {
+                FreeFrame* next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    void* allocate(size_t size) {
+        size_t size_class = (size + FRAME_POOL_GRANULE - 1) / FRAME_POOL_GRANULE;
+        allocations++;
+        if (size_class >= FRAME_POOL_CLASSES) {
+            return ::operator new(size);
+        }
+        if (FreeFrame* frame = free_lists[size_class]) {
+            free_lists[size_class] = frame->next;
+            reused++;
+            return frame;
+        }
+        return ::operator new(size_class * FRAME_POOL_GRANULE);
+    }
+
+    void deallocate(void* pointer, size_t size) {
+        size_t size_class = (size + FRAME_POOL_GRANULE - 1) / FRAME_POOL_GRANULE;
+        if (size_class >= FRAME_POOL_CLASSES) {
+            ::operator delete(pointer);
+            return;
+        }
+        FreeFrame* frame = static_cast<FreeFrame*>(pointer);
+        frame->next = free_lists[size_class];
+        free_lists[size_class] = frame;
+    }
+
+    long allocations = 0;   // Frames requested
+    long reused = 0;        // Requests served from a free list
+
+private:
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+    FreeFrame* free_lists[FRAME_POOL_CLASSES] = {};
+};
+
+FramePool& behaviorFramePool() {
+    static FramePool pool;
+    return pool;
+}
+
+class Behavior;
+
+/**
+ * Kinds of action a behavioral process yields to the engine
+ */
+enum ActionKind {
+    ACTION_COMPUTE,   // Use the CPU for 'amount' time units
+    ACTION_IO,        // Block for 'amount' time units
+    ACTION_LOCK,      // Acquire lock 'lock', blocking while another process holds it
+    ACTION_UNLOCK,    // Release lock 'lock'
+    ACTION_SPAWN,     // Start 'child' as a new process
+    ACTION_WAIT       // Block until every spawned child has finished
+};
+
+/**
+ * One step yielded by a behavioral process with co_yield
+ */
+struct Action {
+    ActionKind kind;
+    double amount = 0;
+    int lock = 0;
+    void* child = nullptr;   // Address of the child's coroutine frame for ACTION_SPAWN
+
+    static Action compute(double amount) { return Action{ACTION_COMPUTE, amount}; }
+    static Action io(double amount) { return Action{ACTION_IO, amount}; }
+    static Action acquire(int lock) { return Action{ACTION_LOCK, 0, lock}; }
+    static Action release(int lock) { return Action{ACTION_UNLOCK, 0, lock}; }
+    static Action spawn(Behavior&& child);
+    static Action wait() { return Action{ACTION_WAIT}; }
+};
+
+/**
+ * Coroutine type of a behavioral process
+ * The body co_yields Actions; frames come from the pooled frame allocator
+ */
+class Behavior {
+public:
+    struct promise_type {
+        Action action{ACTION_WAIT};
+
+        Behavior get_return_object() {
+            return Behavior(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(Action next) noexcept {
+            action = next;
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t size) { return behaviorFramePool().allocate(size); }
+        static void operator delete(void* pointer, size_t size) { behaviorFramePool().deallocate(pointer, size); }
+    };
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    Behavior(Behavior&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Behavior& operator=(Behavior&& other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    Behavior(const Behavior&) = delete;
+    Behavior& operator=(const Behavior&) = delete;
+    ~Behavior() {
+        if (handle) handle.destroy();
+    }
+
+    // Hands ownership of the coroutine to the caller
+    Handle release() {
+        Handle released = handle;
+        handle = nullptr;
+        return released;
+    }
+
+private:
+    explicit Behavior(Handle handle) : handle(handle) {}
+
+    Handle handle;
+};
+
+Action Action::spawn(Behavior&& child) {
+    Action action{ACTION_SPAWN};
+    action.child = child.release().address();
+    return action;
+}
+
+/**
+ * A behavioral process submitted to the engine
+ */
+struct BehaviorProcess {
+    Behavior program;
+    int priority;
+    double arrival_time;
+};
+
+/**
+ * Results of a behavioral workload run
+ */
+struct BehaviorResult {
+    std::vector<double> turnaround_time;   // Per submitted process, including its children
+    double ready_wait = 0;                 // Total time processes spent runnable but not running
+    double lock_wait = 0;                  // Total time processes spent blocked on locks
+    long tasks = 0;                        // Processes run, including spawned children
+    long actions = 0;                      // Actions yielded by all processes
+    long dispatches = 0;
+    double busy_time = 0;
+    double makespan = 0;
+};
+
+/**
+ * Runs behavioral processes on a single CPU under a scheduling policy
+ * COMPUTE actions become CPU bursts handed to the policy (burst_time is the next burst);
+ * IO, LOCK, SPAWN and WAIT are resolved by the engine in zero CPU time
+ * @param roots Processes to run; their coroutines are consumed
+ * @param policy Scheduling policy
+ * @return Turnaround times and blocking statistics
+ */
+BehaviorResult simulateBehaviors(std::vector<BehaviorProcess>& roots, SchedulerPolicy& policy) {
+    struct Task {
+        Behavior::Handle handle;
+        int root;             // Submitted process this task belongs to
+        int parent;           // Spawning task, -1 for submitted processes
+        int live_children;
+        bool waiting;         // Blocked in ACTION_WAIT
+        int priority;
+        double started;
+        double remaining;     // CPU time left in the current burst
+        double since;         // When the task became ready or blocked on a lock
+    };
+
+    BehaviorResult result;
+    int R = roots.size();
+    result.turnaround_time.assign(R, 0);
+    std::vector<int> live_per_root(R, 0);
+    std::vector<int> order(R);
+    for (int i = 0; i < R; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [&](int a, int b) { return roots[a].arrival_time < roots[b].arrival_time; });
+
+    std::vector<Task> tasks;
+    std::vector<int> lock_owner;
+    std::vector<std::deque<int>> lock_waiters;
+    typedef std::pair<double, int> Wakeup;
+    std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup>> io_done;
+    std::vector<int> runnable;   // Tasks to resume at the current time
+    long live = 0;               // Tasks started but not finished
+
+    auto makeReady = [&](int t, double now) {
+        Task& task = tasks[t];
+        task.since = now;
+        int burst = std::max(1, static_cast<int>(std::ceil(task.remaining)));
+        policy.enqueue(ReadyProcess{t, t + 1, task.priority, burst, task.started, task.remaining}, now);
+    };
+
+    auto finish = [&](int t, double now) {
+        tasks[t].handle.destroy();
+        tasks[t].handle = nullptr;
+        live--;
+        policy.onComplete(t, now);
+        for (size_t l = 0; l < lock_owner.size(); l++) {
+            if (lock_owner[l] == t) {
+                // Locks still held at exit are released on the process's behalf
+                lock_owner[l] = -1;
+                if (!lock_waiters[l].empty()) {
+                    int next = lock_waiters[l].front();
+                    lock_waiters[l].pop_front();
+                    lock_owner[l] = next;
+                    result.lock_wait += now - tasks[next].since;
+                    runnable.push_back(next);
+                }
+            }
+        }
+        int root = tasks[t].root;
+        if (--live_per_root[root] == 0) {
+            result.turnaround_time[root] = now - roots[root].arrival_time;
+        }
+        int parent = tasks[t].parent;
+        if (parent != -1 && --tasks[parent].live_children == 0 && tasks[parent].waiting) {
+            tasks[parent].waiting = false;
+            runnable.push_back(parent);
+        }
+    };
+
+    auto addTask = [&](Behavior::Handle handle, int root, int parent, int priority, double now) {
+        tasks.push_back(Task{handle, root, parent, 0, false, priority, now, 0, now});
+        live_per_root[root]++;
+        live++;
+        result.tasks++;
+        runnable.push_back(tasks.size() - 1);
+    };
+
+    // Resumes every runnable task until it yields a CPU burst, blocks or finishes
+    auto drain = [&](double now) {
+        while (!runnable.empty()) {
+            int t = runnable.back();
+            runnable.pop_back();
+            bool resumed = true;
+            while (resumed) {
+                tasks[t].handle.resume();
+                if (tasks[t].handle.done()) {
+                    finish(t, now);
+                    break;
+                }
+                Action action = tasks[t].handle.promise().action;
+                result.actions++;
+                switch (action.kind) {
+                    case ACTION_COMPUTE:
+                        tasks[t].remaining = action.amount;
+                        makeReady(t, now);
+                        resumed = false;
+                        break;
+                    case ACTION_IO:
+                        io_done.push(Wakeup(now + action.amount, t));
+                        resumed = false;
+                        break;
+                    case ACTION_LOCK:
+                        if (action.lock >= static_cast<int>(lock_owner.size())) {
+                            lock_owner.resize(action.lock + 1, -1);
+                            lock_waiters.resize(action.lock + 1);
+                        }
+                        if (lock_owner[action.lock] == -1) {
+                            lock_owner[action.lock] = t;
+                        } else {
+                            tasks[t].since = now;
+                            lock_waiters[action.lock].push_back(t);
+                            resumed = false;
+                        }
+                        break;
+                    case ACTION_UNLOCK:
+                        if (action.lock < static_cast<int>(lock_owner.size()) && lock_owner[action.lock] == t) {
+                            lock_owner[action.lock] = -1;
+                            if (!lock_waiters[action.lock].empty()) {
+                                int next = lock_waiters[action.lock].front();
+                                lock_waiters[action.lock].pop_front();
+                                lock_owner[action.lock] = next;
+                                result.lock_wait += now - tasks[next].since;
+                                runnable.push_back(next);
+                            }
+                        }
+                        break;
+                    case ACTION_SPAWN: {
+                        int root = tasks[t].root;
+                        int priority = tasks[t].priority;
+                        tasks[t].live_children++;
+                        addTask(Behavior::Handle::from_address(action.child), root, t, priority, now);
+                        break;
+                    }
+                    case ACTION_WAIT:
+                        if (tasks[t].live_children > 0) {
+                            tasks[t].waiting = true;
+                            resumed = false;
+                        }
+                        break;
+                }
+            }
+        }
+    };
+
+    size_t next_root = 0;
+    double now = 0;
+    while (next_root < order.size() || live > 0) {
+        while (next_root < order.size() && roots[order[next_root]].arrival_time <= now) {
+            int r = order[next_root++];
+            addTask(roots[r].program.release(), r, -1, roots[r].priority, now);
+        }
+        while (!io_done.empty() && io_done.top().first <= now) {
+            runnable.push_back(io_done.top().second);
+            io_done.pop();
+        }
+        drain(now);
+
+        int t = policy.empty() ? -1 : policy.pickNext(now);
+        if (t == -1) {
+            double next = std::numeric_limits<double>::infinity();
+            if (next_root < order.size()) next = roots[order[next_root]].arrival_time;
+            if (!io_done.empty()) next = std::min(next, io_done.top().first);
+            if (!policy.empty()) next = std::min(next, policy.nextEligibleTime(now));
+            if (next == std::numeric_limits<double>::infinity()) break;   // Everything left is deadlocked
+            now = std::max(now, next);
+            continue;
+        }
+
+        result.ready_wait += now - tasks[t].since;
+        result.dispatches++;
+        double slice = policy.timeSlice(t, now);
+        double run = slice > 0 ? std::min(slice, tasks[t].remaining) : tasks[t].remaining;
+        now += run;
+        result.busy_time += run;
+        tasks[t].remaining -= run;
+        policy.onTick(t, run, now);
+        if (tasks[t].remaining <= 1e-9) {
+            runnable.push_back(t);
+        } else {
+            makeReady(t, now);
+        }
+    }
+
+    for (Task& task : tasks) {
+        if (task.handle) task.handle.destroy();
+    }
+    result.makespan = now;
+    return result;
+}
+
+/**
+ * Uniform random value in [low, high) from a behavior's private generator
+ */
+double behaviorUniform(std::minstd_rand& rng, double low, double high) {
+    return low + (high - low) * (rng() - rng.min()) / (static_cast<double>(rng.max() - rng.min()) + 1);
+}
+
+// Child of a parallel job: one CPU burst
+Behavior parallelWorker(double work) {
+    co_yield Action::compute(work);
+}
+
+// Interactive request: short bursts between I/O, then a short critical section on the session lock
+Behavior interactiveRequest(unsigned seed) {
+    std::minstd_rand rng(seed);
+    for (int step = 0; step < 3; step++) {
+        co_yield Action::compute(behaviorUniform(rng, 0.5, 1.5));
+        co_yield Action::io(behaviorUniform(rng, 2, 8));
+    }
+    co_yield Action::acquire(0);
+    co_yield Action::compute(0.5);
+    co_yield Action::release(0);
+}
+
+// Database writer: computes and flushes to disk while holding a table lock
+Behavior databaseWriter(unsigned seed) {
+    std::minstd_rand rng(seed);
+    int table = 1 + rng() % BEHAVIOR_TABLE_LOCKS;
+    co_yield Action::compute(behaviorUniform(rng, 0.5, 1.5));
+    co_yield Action::acquire(table);
+    co_yield Action::compute(behaviorUniform(rng, 1, 3));
+    co_yield Action::io(behaviorUniform(rng, 1, 3));
+    co_yield Action::release(table);
+    co_yield Action::compute(1);
+}
+
+// Parallel job: forks workers, waits for all of them, then merges
+Behavior parallelJob(unsigned seed) {
+    std::minstd_rand rng(seed);
+    co_yield Action::compute(2);
+    int width = 2 + rng() % 5;
+    for (int w = 0; w < width; w++) {
+        co_yield Action::spawn(parallelWorker(behaviorUniform(rng, 1, 4)));
+    }
+    co_yield Action::wait();
+    co_yield Action::compute(1);
+}
+
+// Batch job: long CPU phases with occasional checkpoints
+Behavior batchJob(unsigned seed) {
+    std::minstd_rand rng(seed);
+    for (int phase = 0; phase < 4; phase++) {
+        co_yield Action::compute(behaviorUniform(rng, 4, 8));
+        co_yield Action::io(1);
+    }
+}
+
+/**
+ * Generates a mix of interactive, database, parallel and batch behavioral processes
+ * @param n Number of processes
+ * @param arrival_rate Mean arrivals per time unit (Poisson)
+ * @param seed Random seed
+ * @return Processes with their coroutine programs
+ */
+std::vector<BehaviorProcess> generateBehaviorWorkload(int n, double arrival_rate, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> gap(arrival_rate);
+    std::vector<BehaviorProcess> workload;
+    workload.reserve(n);
+    double time = 0;
+    for (int i = 0; i < n; i++) {
+        time += gap(rng);
+        unsigned program_seed = rng();
+        switch (i % 4) {
+            case 0: workload.push_back(BehaviorProcess{interactiveRequest(program_seed), 1, time}); break;
+            case 1: workload.push_back(BehaviorProcess{databaseWriter(program_seed), 2, time}); break;
+            case 2: workload.push_back(BehaviorProcess{parallelJob(program_seed), 2, time}); break;
+            default: workload.push_back(BehaviorProcess{batchJob(program_seed), 3, time}); break;
+        }
+    }
+    return workload;
+}
+
+/**
+ * Behavioral Workload Simulation
+ * Runs the same coroutine-defined workload under FCFS, SJF, Priority and Round Robin
+ * @param count Number of submitted processes
+ * @return Average turnaround time under Round Robin
+ */
+double behavioral_workload_simulation(int count) {
+    std::cout << "\n" << std::string(84, '=') << std::endl;
+    std::cout << "COROUTINE BEHAVIORAL WORKLOADS (Quantum = " << QUANTUM << ")" << std::endl;
+    std::cout << std::string(84, '=') << std::endl;
+    std::cout << "Processes: " << count << " (interactive, database writer, parallel job, batch), "
+              << "arrival rate " << BEHAVIOR_ARRIVAL_RATE << "/unit" << std::endl;
+    std::cout << std::string(84, '-') << std::endl;
+    std::cout << std::setw(13) << std::left << "Policy" << std::right
+              << std::setw(9) << "Avg TAT" << std::setw(9) << "p99 TAT"
+              << std::setw(11) << "Ready Wait" << std::setw(10) << "Lock Wait"
+              << std::setw(7) << "Util" << std::setw(9) << "Tasks"
+              << std::setw(12) << "Actions/s" << std::endl;
+    std::cout << std::string(84, '-') << std::endl;
+
+    double rr_turnaround = 0;
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    for (PolicyKind kind : kinds) {
+        std::vector<BehaviorProcess> workload = generateBehaviorWorkload(count, BEHAVIOR_ARRIVAL_RATE, BEHAVIOR_SEED);
+        std::unique_ptr<SchedulerPolicy> policy = makePolicy(kind);
+
+        auto start = std::chrono::steady_clock::now();
+        BehaviorResult result = simulateBehaviors(workload, *policy);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        LatencySummary turnaround = summarizeLatencies(result.turnaround_time);
+        std::cout << std::setw(13) << std::left << policyKindName(kind) << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(9) << turnaround.mean << std::setw(9) << turnaround.p99
+                  << std::setw(11) << result.ready_wait / count << std::setw(10) << result.lock_wait / count
+                  << std::setw(6) << 100.0 * result.busy_time / result.makespan << "%"
+                  << std::setw(9) << result.tasks
+                  << std::setw(11) << std::setprecision(1) << result.actions / elapsed.count() / 1e6 << "M"
+                  << std::endl;
+        if (kind == POLICY_RR) {
+            rr_turnaround = turnaround.mean;
+        }
+    }
+    const FramePool& pool = behaviorFramePool();
+    std::cout << std::string(84, '-') << std::endl;
+    std::cout << "Wait columns are per submitted process; turnaround includes spawned children" << std::endl;
+    std::cout << "Coroutine frames: " << pool.allocations << " allocated, " << std::fixed << std::setprecision(1)
+              << 100.0 * pool.reused / std::max(1L, pool.allocations) << "% served from the pool" << std::endl;
+    std::cout << std::string(84, '=') << std::endl;
+
+    return rr_turnaround;
+}
+
+/**
+ * Single-CPU scheduling instance for the exact solver (preemption allowed)
+ */
+struct ScheduleInstance {
+    std::vector<double> release;      // Arrival times
+    std::vector<double> processing;   // Burst times
+    std::vector<double> weight;       // Objective weights (all 1 for mean waiting time)
+};
+
+/**
+ * Outcome of an exact solve
+ */
+struct OptimalSchedule {
+    double objective = 0;    // Best total weighted completion time found
+    long nodes = 0;          // Search nodes expanded
+    bool proven = false;     // False if the node limit stopped the search early
+};
+
+/**
+ * Parallel branch-and-bound for 1 | r_j, pmtn | sum w_j C_j
+ * Decisions are made only at arrivals and completions: some optimal schedule preempts only
+ * when a process arrives, so each branch runs one ready process until it finishes or the next
+ * arrival. Pruning uses a release-relaxed Smith's-rule lower bound, pairwise dominance among
+ * ready processes (never run j while a ready i is both heavier and shorter) and a per-thread
+ * memo of (time, remaining work) states already reached at lower cost.
+ */
+class BranchAndBoundSolver {
+public:
+    BranchAndBoundSolver(const ScheduleInstance& instance, int threads)
+        : instance(instance), threads(std::max(1, threads)) {
+        N = instance.release.size();
+        for (int i = 0; i < N; i++) {
+            releases.push_back(instance.release[i]);
+        }
+        std::sort(releases.begin(), releases.end());
+    }
+
+    /**
+     * Solves the instance
+     * @param upper_bound Objective of any feasible schedule (the search only looks for better ones)
+     * @return Best objective found and search statistics
+     */
+    OptimalSchedule solve(double upper_bound) {
+        incumbent.store(upper_bound);
+        nodes.store(0);
+        aborted.store(false);
+
+        // Expand the first decisions breadth-first so every thread has subtrees to search
+        std::vector<State> frontier(1, State{0, 0, instance.processing});
+        for (int level = 0; level < BNB_SPLIT_DEPTH; level++) {
+            std::vector<State> next;
+            for (const State& state : frontier) {
+                std::vector<State> children = expand(state);
+                if (children.empty()) next.push_back(state);
+                next.insert(next.end(), children.begin(), children.end());
+            }
+            frontier.swap(next);
+        }
+
+        std::atomic<size_t> next_subtree(0);
+        auto worker = [&]() {
+            std::unordered_map<std::string, double> memo;
+            size_t i;
+            while ((i = next_subtree++) < frontier.size()) {
+                search(frontier[i], memo);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back(worker);
+        }
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+
+        OptimalSchedule result;
+        result.objective = incumbent.load();
+        result.nodes = nodes.load();
+        result.proven = !aborted.load();
+        return result;
+    }
+
+private:
+    struct State {
+        double time;
+        double cost;                    // Weighted completion time of finished processes
+        std::vector<double> remaining;
+    };
+
+    double nextRelease(double time) const {
+        auto it = std::upper_bound(releases.begin(), releases.end(), time + 1e-9);
+        return it == releases.end() ? std::numeric_limits<double>::infinity() : *it;
+    }
+
+    bool ready(const State& state, int i) const {
+        return state.remaining[i] > 1e-9 && instance.release[i] <= state.time + 1e-9;
+    }
+
+    // Weighted completion time of the given processes run by Smith's rule from 'time'
+    double smithCost(const State& state, const std::vector<int>& jobs) const {
+        std::vector<int> order(jobs);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return instance.weight[a] * state.remaining[b] > instance.weight[b] * state.remaining[a];
+        });
+        double time = state.time, cost = 0;
+        for (int i : order) {
+            time += state.remaining[i];
+            cost += instance.weight[i] * time;
+        }
+        return cost;
+    }
+
+    // Ready processes ignore later arrivals; unreleased ones start the moment they arrive
+    double lowerBound(const State& state) const {
+        std::vector<int> released;
+        double bound = state.cost;
+        for (int i = 0; i < N; i++) {
+            if (state.remaining[i] <= 1e-9) continue;
+            if (instance.release[i] <= state.time + 1e-9) released.push_back(i);
+            else bound += instance.weight[i] * (instance.release[i] + state.remaining[i]);
+        }
+        return bound + smithCost(state, released);
+    }
+
+    // Children of a decision point, most promising first; empty for leaves
+    std::vector<State> expand(const State& state) const {
+        std::vector<State> children;
+        std::vector<int> candidates;
+        for (int j = 0; j < N; j++) {
+            if (!ready(state, j)) continue;
+            bool dominated = false;
+            for (int i = 0; i < N && !dominated; i++) {
+                if (i == j || !ready(state, i)) continue;
+                double wi = instance.weight[i], wj = instance.weight[j];
+                double ri = state.remaining[i], rj = state.remaining[j];
+                if (wi >= wj && ri <= rj && (wi > wj || ri < rj || i < j)) dominated = true;
+            }
+            if (!dominated) candidates.push_back(j);
+        }
+        if (candidates.empty()) {
+            double release = nextRelease(state.time);
+            if (release == std::numeric_limits<double>::infinity()) return children;
+            State idle = state;
+            idle.time = release;   // CPU idles until the next arrival
+            children.push_back(idle);
+            return children;
+        }
+        std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+            return instance.weight[a] * state.remaining[b] > instance.weight[b] * state.remaining[a];
+        });
+        double release = nextRelease(state.time);
+        for (int j : candidates) {
+            State child = state;
+            double run = std::min(child.remaining[j], release - child.time);
+            child.time += run;
+            child.remaining[j] -= run;
+            if (child.remaining[j] <= 1e-9) {
+                child.remaining[j] = 0;
+                child.cost += instance.weight[j] * child.time;
+            }
+            children.push_back(child);
+        }
+        return children;
+    }
+
+    void offer(double objective) {
+        double best = incumbent.load();
+        while (objective < best && !incumbent.compare_exchange_weak(best, objective)) {}
+    }
+
+    void search(const State& state, std::unordered_map<std::string, double>& memo) {
+        if (aborted.load(std::memory_order_relaxed)) return;
+        if (++nodes > BNB_NODE_LIMIT) {
+            aborted.store(true);
+            return;
+        }
+
+        // Once everything has arrived, Smith's rule finishes the schedule optimally
+        if (nextRelease(state.time) == std::numeric_limits<double>::infinity()) {
+            std::vector<int> left;
+            for (int i = 0; i < N; i++) {
+                if (state.remaining[i] > 1e-9) left.push_back(i);
+            }
+            State start = state;
+            for (int i : left) start.time = std::max(start.time, instance.release[i]);
+            offer(state.cost + smithCost(start, left));
+            return;
+        }
+        if (lowerBound(state) >= incumbent.load() - 1e-9) return;
+
+        std::string key(reinterpret_cast<const char*>(&state.time), sizeof(double));
+        key.append(reinterpret_cast<const char*>(state.remaining.data()), N * sizeof(double));
+        auto seen = memo.find(key);
+        if (seen != memo.end() && seen->second <= state.cost + 1e-9) return;
+        if (seen != memo.end()) seen->second = state.cost;
+        else if (memo.size() < BNB_MEMO_LIMIT) memo.emplace(key, state.cost);
+
+        for (const State& child : expand(state)) {
+            search(child, memo);
+        }
+    }
+
+    const ScheduleInstance& instance;
+    int threads;
+    int N;
+    std::vector<double> releases;
+    std::atomic<double> incumbent{0};
+    std::atomic<long> nodes{0};
+    std::atomic<bool> aborted{false};
+};
+
+/**
+ * Preemptive weighted shortest-remaining-time heuristic, used as the solver's first incumbent
+ * @return Total weighted completion time
+ */
+double weightedSrptCost(const ScheduleInstance& instance) {
+    int N = instance.release.size();
+    std::vector<double> remaining(instance.processing);
+    double time = 0, cost = 0;
+    int completed = 0;
+    while (completed < N) {
+        int best = -1;
+        double next_release = std::numeric_limits<double>::infinity();
+        for (int i = 0; i < N; i++) {
+            if (remaining[i] <= 0) continue;
+            if (instance.release[i] > time) {
+                next_release = std::min(next_release, instance.release[i]);
+            } else if (best == -1 || instance.weight[i] * remaining[best] > instance.weight[best] * remaining[i]) {
+                best = i;
+            }
+        }
+        if (best == -1) {
+            time = next_release;
+            continue;
+        }
+        double run = std::min(remaining[best], next_release - time);
+        time += run;
+        remaining[best] -= run;
+        if (remaining[best] <= 0) {
+            cost += instance.weight[best] * time;
+            completed++;
+        }
+    }
+    return cost;
+}
+
+/**
+ * Optimality Gap Analysis
+ * Solves sampled small workloads exactly and reports how far SJF, Priority and RR are from optimal,
+ * both for mean waiting time and for priority-weighted flow time
+ * (weight = MAX_PRIORITY + 1 - priority; minimizing it is equivalent to minimizing weighted completion time)
+ * @param num_processes Processes per sampled workload
+ * @return Mean waiting-time gap of SJF in percent
+ */
+double optimality_gap_analysis(int num_processes) {
+    int threads = std::max(1, std::min(BNB_MAX_THREADS, static_cast<int>(std::thread::hardware_concurrency())));
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+
+    std::cout << "\n" << std::string(76, '=') << std::endl;
+    std::cout << "OPTIMALITY GAP (Branch and Bound, preemptive single CPU)" << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+    std::cout << "Workloads: " << BNB_SAMPLES << " x " << num_processes << " processes, offered load "
+              << BNB_OFFERED_LOAD << ", " << threads << " solver thread(s)" << std::endl;
+
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    const int K = 4;
+    double wait_gap[K] = {0}, wait_gap_max[K] = {0}, flow_gap[K] = {0}, flow_gap_max[K] = {0};
+    long total_nodes = 0;
+    int proven = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int s = 0; s < BNB_SAMPLES; s++) {
+        std::vector<Process> processes =
+            generateArrivalWorkload(num_processes, BNB_OFFERED_LOAD / mean_burst, BNB_SEED + s);
+
+        ScheduleInstance unweighted, weighted;
+        double release_sum = 0, burst_sum = 0, weighted_release_sum = 0;
+        for (const Process& process : processes) {
+            double weight = MAX_PRIORITY + 1 - process.priority;
+            for (ScheduleInstance* instance : {&unweighted, &weighted}) {
+                instance->release.push_back(process.arrival_time);
+                instance->processing.push_back(process.burst_time);
+            }
+            unweighted.weight.push_back(1);
+            weighted.weight.push_back(weight);
+            release_sum += process.arrival_time;
+            burst_sum += process.burst_time;
+            weighted_release_sum += weight * process.arrival_time;
+        }
+
+        OptimalSchedule best_wait = BranchAndBoundSolver(unweighted, threads).solve(weightedSrptCost(unweighted));
+        OptimalSchedule best_flow = BranchAndBoundSolver(weighted, threads).solve(weightedSrptCost(weighted));
+        total_nodes += best_wait.nodes + best_flow.nodes;
+        proven += best_wait.proven && best_flow.proven;
+        double optimal_wait = (best_wait.objective - release_sum - burst_sum) / num_processes;
+        double optimal_flow = best_flow.objective - weighted_release_sum;
+
+        for (int k = 0; k < K; k++) {
+            EngineResult result = simulateWorkload(processes, *makePolicy(kinds[k]));
+            double flow = 0;
+            for (int i = 0; i < num_processes; i++) {
+                flow += weighted.weight[i] * result.turnaround_time[i];
+            }
+            double wg = optimal_wait > 0 ? 100.0 * (result.averageWaitingTime() - optimal_wait) / optimal_wait : 0;
+            double fg = 100.0 * (flow - optimal_flow) / optimal_flow;
+            wait_gap[k] += wg / BNB_SAMPLES;
+            flow_gap[k] += fg / BNB_SAMPLES;
+            wait_gap_max[k] = std::max(wait_gap_max[k], wg);
+            flow_gap_max[k] = std::max(flow_gap_max[k], fg);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << std::setw(14) << std::left << "Policy" << std::right
+              << std::setw(15) << "Wait Gap Avg" << std::setw(15) << "Wait Gap Max"
+              << std::setw(16) << "W.Flow Gap Avg" << std::setw(16) << "W.Flow Gap Max" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+    for (int k = 0; k < K; k++) {
+        std::cout << std::setw(14) << std::left << policyKindName(kinds[k]) << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << wait_gap[k] << "%" << std::setw(14) << wait_gap_max[k] << "%"
+                  << std::setw(15) << flow_gap[k] << "%" << std::setw(15) << flow_gap_max[k] << "%" << std::endl;
+    }
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << "Optimum proven on " << proven << "/" << BNB_SAMPLES << " workloads, "
+              << total_nodes << " nodes in " << std::setprecision(2) << elapsed.count() << " s" << std::endl;
+    std::cout << "Gaps are relative to the preemptive optimum, which no non-preemptive policy can beat" << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+
+    return wait_gap[1];
+}
+
+/**
+ * Arrival rate and burst-time moments of a workload, the inputs of the analytic models
+ */
+struct WorkloadMoments {
+    double arrival_rate = 0;                    // Arrivals per time unit
+    double mean_burst = 0;                      // E[S]
+    double second_moment = 0;                   // E[S^2]
+    std::map<int, double> burst_share;          // Fraction of processes with each burst time
+    std::map<int, double> priority_share;       // Fraction of processes at each priority
+    std::map<int, double> priority_mean_burst;  // E[S] within each priority level
+
+    double utilization() const { return arrival_rate * mean_burst; }
+};
+
+/**
+ * Measures the analytic model inputs from a workload
+ * @param processes Workload with arrival times
+ * @return Arrival rate and burst moments
+ */
+WorkloadMoments measureWorkload(const std::vector<Process>& processes) {
+    WorkloadMoments moments;
+    int N = processes.size();
+    if (N == 0) return moments;
+    double first = processes[0].arrival_time, last = processes[0].arrival_time;
+    for (const Process& process : processes) {
+        first = std::min(first, process.arrival_time);
+        last = std::max(last, process.arrival_time);
+        moments.mean_burst += process.burst_time / static_cast<double>(N);
+        moments.second_moment += process.burst_time * static_cast<double>(process.burst_time) / N;
+        moments.burst_share[process.burst_time] += 1.0 / N;
+        moments.priority_share[process.priority] += 1.0 / N;
+        moments.priority_mean_burst[process.priority] += process.burst_time;
+    }
+    for (auto& level : moments.priority_mean_burst) {
+        level.second /= moments.priority_share[level.first] * N;
+    }
+    // N arrivals span N-1 gaps; a Poisson process started at time 0 spans N of them
+    moments.arrival_rate = last > first ? (first > 0 ? N / last : (N - 1) / (last - first)) : 0;
+    return moments;
+}
+
+/**
+ * Non-preemptive class-based M/G/1 waiting time (Cobham's formula)
+ * Class k waits W0 / ((1 - sigma_{k-1}) (1 - sigma_k)), where sigma_k is the load of classes served before or with k
+ * @param share Fraction of arrivals in each class, in service order
+ * @param mean_burst Mean burst of each class
+ * @return Mean waiting time over all classes (infinity when overloaded)
+ */
+double cobhamWaitingTime(const WorkloadMoments& moments, const std::vector<double>& share,
+                         const std::vector<double>& mean_burst) {
+    double residual = moments.arrival_rate * moments.second_moment / 2;   // W0: mean residual work in service
+    double sigma = 0, wait = 0;
+    for (size_t k = 0; k < share.size(); k++) {
+        double before = sigma;
+        sigma += moments.arrival_rate * share[k] * mean_burst[k];
+        if (sigma >= 1) return std::numeric_limits<double>::infinity();
+        wait += share[k] * residual / ((1 - before) * (1 - sigma));
+    }
+    return wait;
+}
+
+/**
+ * M/M/1 mean waiting time: assumes exponential bursts whatever the workload's real distribution
+ */
+double mm1WaitingTime(const WorkloadMoments& moments) {
+    double rho = moments.utilization();
+    if (rho >= 1) return std::numeric_limits<double>::infinity();
+    return rho * moments.mean_burst / (1 - rho);
+}
+
+/**
+ * Analytic mean waiting time of a policy
+ * FCFS uses Pollaczek-Khinchine, SJF and Priority use Cobham's non-preemptive class formula
+ * and Round Robin is approximated by processor sharing
+ * @param moments Workload model inputs
+ * @param kind Policy to predict
+ * @return Predicted mean waiting time (infinity when the load is 1 or more)
+ */
+double predictWaitingTime(const WorkloadMoments& moments, PolicyKind kind) {
+    double rho = moments.utilization();
+    if (rho >= 1) return std::numeric_limits<double>::infinity();
+
+    std::vector<double> share, mean_burst;
+    switch (kind) {
+        case POLICY_FCFS:
+            return moments.arrival_rate * moments.second_moment / (2 * (1 - rho));
+        case POLICY_SJF:
+            for (const auto& size : moments.burst_share) {
+                share.push_back(size.second);
+                mean_burst.push_back(size.first);
+            }
+            return cobhamWaitingTime(moments, share, mean_burst);
+        case POLICY_PRIORITY:
+            for (const auto& level : moments.priority_share) {
+                share.push_back(level.second);
+                mean_burst.push_back(moments.priority_mean_burst.at(level.first));
+            }
+            return cobhamWaitingTime(moments, share, mean_burst);
+        case POLICY_RR:
+            // Processor sharing: a burst of x takes x / (1 - rho), so it waits x * rho / (1 - rho)
+            return moments.mean_burst * rho / (1 - rho);
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+/**
+ * Analytic Prediction vs Simulation
+ * Sweeps offered load, predicts each policy's mean waiting time analytically, flags simulations
+ * that diverge from the prediction and shows which configurations a sweep could skip
+ * @param num_processes Arrivals simulated per configuration
+ * @return Number of configurations whose simulation diverged from the model
+ */
+int analytic_prediction(int num_processes) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "ANALYTIC PREDICTION vs SIMULATION (mean waiting time)" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << "Models: FCFS = M/G/1 Pollaczek-Khinchine, SJF/Priority = Cobham (non-preemptive),"
+              << std::endl << "        RR = processor sharing; M/M/1 shown for reference" << std::endl;
+    std::cout << "Processes per run: " << num_processes << ", divergence threshold "
+              << std::fixed << std::setprecision(0) << 100 * ANALYTIC_DIVERGENCE << "%" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(6) << "Load" << "  " << std::setw(13) << std::left << "Policy" << std::right
+              << std::setw(9) << "M/M/1" << std::setw(10) << "Analytic" << std::setw(11) << "Simulated"
+              << std::setw(9) << "Error" << std::setw(8) << "Sweep" << std::setw(12) << "Flag" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    int diverged = 0, pruned = 0, configurations = 0;
+    double analytic_seconds = 0, simulation_seconds = 0;
+    for (double load : ANALYTIC_LOADS) {
+        std::vector<Process> processes =
+            generateArrivalWorkload(num_processes, load / mean_burst, ANALYTIC_SEED);
+
+        WorkloadMoments moments = measureWorkload(processes);
+        auto start = std::chrono::steady_clock::now();
+        double predicted[4], best = std::numeric_limits<double>::infinity();
+        for (int k = 0; k < 4; k++) {
+            predicted[k] = predictWaitingTime(moments, kinds[k]);
+            best = std::min(best, predicted[k]);
+        }
+        analytic_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int k = 0; k < 4; k++) {
+            start = std::chrono::steady_clock::now();
+            EngineResult result = simulateWorkload(processes, *makePolicy(kinds[k]));
+            simulation_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double simulated = result.averageWaitingTime();
+            double error = (simulated - predicted[k]) / predicted[k];
+            bool keep = predicted[k] <= ANALYTIC_PRUNE_FACTOR * best;
+            bool diverges = std::fabs(error) > ANALYTIC_DIVERGENCE;
+            configurations++;
+            pruned += !keep;
+            diverged += diverges;
+
+            std::cout << std::setprecision(2) << std::setw(6) << moments.utilization() << "  "
+                      << std::setw(13) << std::left << policyKindName(kinds[k]) << std::right
+                      << std::setw(9) << mm1WaitingTime(moments) << std::setw(10) << predicted[k]
+                      << std::setw(11) << simulated << std::setw(8) << std::setprecision(1) << 100 * error << "%"
+                      << std::setw(8) << (keep ? "keep" : "prune")
+                      << std::setw(12) << (diverges ? "DIVERGES" : "ok") << std::endl;
+        }
+    }
+
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << "Analytic models (from measured moments): " << configurations << " configurations in " << std::setprecision(1)
+              << analytic_seconds * 1e6 << " us; simulation: " << simulation_seconds * 1e3 << " ms" << std::endl;
+    std::cout << "A sweep keeping policies within " << std::setprecision(1) << ANALYTIC_PRUNE_FACTOR
+              << "x of the best prediction would skip " << pruned << " of " << configurations << " simulations" << std::endl;
+    std::cout << "Divergent configurations: " << diverged
+              << " (non-Poisson effects, RR quantum vs processor sharing, or too few samples near saturation)" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+
+    return diverged;
+}
+
+/**
+ * Formats a confidence interval as "mean +- half-width"
+ */
+std::string formatInterval(const ConfidenceInterval& ci) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(2) << ci.mean << " +- " << ci.half_width;
+    return text.str();
+}
+
+/**
+ * Applies control variates with known zero mean by least squares on the replications
+ * @param outputs One output per replication
+ * @param controls Control observations per replication, each centered on its known expectation
+ * @return Adjusted outputs (same expectation, lower variance when the controls correlate)
+ */
+std::vector<double> applyControlVariates(const std::vector<double>& outputs,
+                                         const std::vector<std::vector<double>>& controls) {
+    int R = outputs.size();
+    int K = controls.empty() ? 0 : controls[0].size();
+    double y_mean = 0;
+    std::vector<double> c_mean(K, 0);
+    for (int r = 0; r < R; r++) {
+        y_mean += outputs[r] / R;
+        for (int k = 0; k < K; k++) c_mean[k] += controls[r][k] / R;
+    }
+    // Normal equations S_cc * beta = S_cy, solved by Gaussian elimination (K is tiny)
+    std::vector<std::vector<double>> system(K, std::vector<double>(K + 1, 0));
+    for (int r = 0; r < R; r++) {
+        for (int i = 0; i < K; i++) {
+            for (int j = 0; j < K; j++) {
+                system[i][j] += (controls[r][i] - c_mean[i]) * (controls[r][j] - c_mean[j]);
+            }
+            system[i][K] += (controls[r][i] - c_mean[i]) * (outputs[r] - y_mean);
+        }
+    }
+    for (int i = 0; i < K; i++) {
+        if (std::fabs(system[i][i]) < 1e-12) return outputs;
+        for (int j = 0; j < K; j++) {
+            if (j == i) continue;
+            double factor = system[j][i] / system[i][i];
+            for (int c = i; c <= K; c++) system[j][c] -= factor * system[i][c];
+        }
+    }
+    std::vector<double> adjusted(outputs);
+    for (int r = 0; r < R; r++) {
+        for (int k = 0; k < K; k++) {
+            adjusted[r] -= system[k][K] / system[k][k] * controls[r][k];
+        }
+    }
+    return adjusted;
+}
+
+/**
+ * Variance Reduction Study
+ * Estimates each policy's mean waiting time from the same number of replications using
+ * independent streams, common random numbers, antithetic pairs and control variates
+ * @param replications Workloads simulated per policy and method
+ * @return Replications saved by the best method on the RR - SJF difference (variance ratio)
+ */
+double variance_reduction_study(int replications) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    double arrival_rate = VR_OFFERED_LOAD / mean_burst;
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    const int K = 4;
+    const int SJF = 1, RR = 3;
+
+    struct Replication {
+        double waiting_time;
+        std::vector<double> controls;   // Sample mean burst and gap minus their expectations
+    };
+    auto replicate = [&](PolicyKind kind, unsigned seed, bool antithetic) {
+        std::vector<Process> processes = generateReplicationWorkload(VR_PROCESS_COUNT, arrival_rate, seed, antithetic);
+        double bursts = 0;
+        for (const Process& process : processes) bursts += process.burst_time;
+        EngineResult result = simulateWorkload(processes, *makePolicy(kind));
+        return Replication{result.averageWaitingTime(),
+                           {bursts / VR_PROCESS_COUNT - mean_burst,
+                            processes.back().arrival_time / VR_PROCESS_COUNT - 1 / arrival_rate}};
+    };
+
+    std::vector<std::string> methods = {"Independent Streams", "Common Random Numbers",
+                                        "Antithetic Pairs (CRN)", "Control Variates (CRN)"};
+    std::vector<std::vector<ConfidenceInterval>> estimates(methods.size());
+    std::vector<ConfidenceInterval> differences;
+
+    // Independent: every policy draws its own workloads
+    std::vector<std::vector<double>> independent(K);
+    for (int k = 0; k < K; k++) {
+        for (int r = 0; r < replications; r++) {
+            independent[k].push_back(replicate(kinds[k], VR_SEED + 1000 * (k + 1) + r, false).waiting_time);
+        }
+        estimates[0].push_back(confidenceInterval(independent[k]));
+    }
+    std::vector<double> difference;
+    for (int r = 0; r < replications; r++) difference.push_back(independent[RR][r] - independent[SJF][r]);
+    differences.push_back(confidenceInterval(difference));
+
+    // Common random numbers: replication r is the same workload for every policy
+    std::vector<std::vector<Replication>> common(K);
+    for (int k = 0; k < K; k++) {
+        for (int r = 0; r < replications; r++) {
+            common[k].push_back(replicate(kinds[k], VR_SEED + r, false));
+        }
+    }
+    auto outputs = [&](int k) {
+        std::vector<double> values;
+        for (const Replication& replication : common[k]) values.push_back(replication.waiting_time);
+        return values;
+    };
+    for (int k = 0; k < K; k++) estimates[1].push_back(confidenceInterval(outputs(k)));
+    difference.clear();
+    for (int r = 0; r < replications; r++) difference.push_back(common[RR][r].waiting_time - common[SJF][r].waiting_time);
+    differences.push_back(confidenceInterval(difference));
+
+    // Antithetic: half as many seeds, each paired with its mirrored workload
+    std::vector<std::vector<double>> pairs(K);
+    for (int k = 0; k < K; k++) {
+        for (int r = 0; r < replications / 2; r++) {
+            pairs[k].push_back((replicate(kinds[k], VR_SEED + r, false).waiting_time +
+                                replicate(kinds[k], VR_SEED + r, true).waiting_time) / 2);
+        }
+        estimates[2].push_back(confidenceInterval(pairs[k]));
+    }
+    difference.clear();
+    for (int r = 0; r < replications / 2; r++) difference.push_back(pairs[RR][r] - pairs[SJF][r]);
+    differences.push_back(confidenceInterval(difference));
+
+    // Control variates: CRN outputs regressed on sample mean burst and gap, whose expectations are known
+    std::vector<std::vector<double>> controls;
+    for (const Replication& replication : common[0]) controls.push_back(replication.controls);
+    int lost_df = controls.empty() ? 0 : controls[0].size();
+    for (int k = 0; k < K; k++) {
+        estimates[3].push_back(confidenceInterval(applyControlVariates(outputs(k), controls), lost_df));
+    }
+    difference.clear();
+    for (int r = 0; r < replications; r++) difference.push_back(common[RR][r].waiting_time - common[SJF][r].waiting_time);
+    differences.push_back(confidenceInterval(applyControlVariates(difference, controls), lost_df));
+
+    std::cout << "\n" << std::string(88, '=') << std::endl;
+    std::cout << "VARIANCE REDUCTION (mean waiting time, 95% confidence intervals)" << std::endl;
+    std::cout << std::string(88, '=') << std::endl;
+    std::cout << "Replications: " << replications << " workloads of " << VR_PROCESS_COUNT
+              << " processes per policy, offered load " << VR_OFFERED_LOAD << std::endl;
+    std::cout << std::string(88, '-') << std::endl;
+    std::cout << std::setw(24) << std::left << "Method" << std::right;
+    for (PolicyKind kind : kinds) std::cout << std::setw(16) << policyKindName(kind);
+    std::cout << std::endl << std::string(88, '-') << std::endl;
+    for (size_t m = 0; m < methods.size(); m++) {
+        std::cout << std::setw(24) << std::left << methods[m] << std::right;
+        for (const ConfidenceInterval& ci : estimates[m]) std::cout << std::setw(16) << formatInterval(ci);
+        std::cout << std::endl;
+    }
+
+    std::cout << "\n" << std::string(88, '-') << std::endl;
+    std::cout << std::setw(24) << std::left << "RR - SJF Difference" << std::right
+              << std::setw(12) << "Estimate" << std::setw(13) << "Half-Width"
+              << std::setw(22) << "Replications Saved" << std::endl;
+    std::cout << std::string(88, '-') << std::endl;
+    double best_saving = 1;
+    for (size_t m = 0; m < methods.size(); m++) {
+        // Variance ratio at equal cost: how many independent replications one of these is worth
+        double saving = std::pow(differences[0].half_width / differences[m].half_width, 2);
+        if (m > 0) best_saving = std::max(best_saving, saving);
+        std::cout << std::setw(24) << std::left << methods[m] << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << differences[m].mean << std::setw(13) << differences[m].half_width
+                  << std::setw(21) << std::setprecision(1) << saving << "x" << std::endl;
+    }
+    std::cout << std::string(88, '-') << std::endl;
+    std::cout << "Replications Saved: squared half-width ratio against independent streams at equal cost" << std::endl;
+    std::cout << std::string(88, '=') << std::endl;
+
+    return best_saving;
+}
+
+/**
+ * Result of a batch-means analysis of one steady-state run
+ */
+struct BatchMeansResult {
+    ConfidenceInterval ci;
+    int batches = 0;
+    long batch_size = 0;
+    double lag1 = 0;   // Lag-1 autocorrelation of the batch means
+};
+
+/**
+ * Batch-means confidence interval for the steady-state mean of a correlated output series
+ * Drops a warm-up prefix, then merges adjacent batches until the batch means look uncorrelated
+ * @param series Outputs in the order the system produced them
+ * @return Interval, final batch layout and remaining lag-1 autocorrelation
+ */
+BatchMeansResult batchMeans(const std::vector<double>& series) {
+    BatchMeansResult result;
+    size_t warmup = static_cast<size_t>(series.size() * BATCH_WARMUP_FRACTION);
+    int batches = BATCH_MAX_BATCHES;
+    while (true) {
+        long size = (series.size() - warmup) / batches;
+        std::vector<double> means(batches, 0);
+        for (int b = 0; b < batches; b++) {
+            for (long i = 0; i < size; i++) {
+                means[b] += series[warmup + b * size + i] / size;
+            }
+        }
+        result.ci = confidenceInterval(means);
+        double numerator = 0;
+        for (int b = 0; b + 1 < batches; b++) {
+            numerator += (means[b] - result.ci.mean) * (means[b + 1] - result.ci.mean);
+        }
+        result.lag1 = result.ci.variance > 0 ? numerator / ((batches - 1) * result.ci.variance) : 0;
+        result.batches = batches;
+        result.batch_size = size;
+        if (result.lag1 <= BATCH_MAX_LAG1 || batches / 2 < BATCH_MIN_BATCHES) break;
+        batches /= 2;
+    }
+    return result;
+}
+
+/**
+ * Adaptive Replication Analysis
+ * Launches independent replications in parallel rounds until every metric's 95% confidence
+ * interval is within the target relative half-width, then estimates steady-state waiting time
+ * by batch means, lengthening the run until it meets the same target
+ * @param target Target half-width as a fraction of the mean
+ * @return Replications used by the terminating-run analysis
+ */
+int adaptive_replication(double target) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    double arrival_rate = ADAPTIVE_OFFERED_LOAD / mean_burst;
+    int threads = std::max(1, std::min(ADAPTIVE_MAX_THREADS, static_cast<int>(std::thread::hardware_concurrency())));
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    const int K = 4;
+    const int METRICS = 2 * K;   // Mean waiting time and p95 turnaround per policy
+
+    auto metricName = [&](int m) {
+        return std::string(policyKindName(kinds[m / 2])) + (m % 2 == 0 ? " mean WT" : " p95 TAT");
+    };
+
+    // Replication r fills samples[r]; every policy sees the same workload (common random numbers)
+    std::vector<std::vector<double>> samples;
+    auto runRound = [&](int count) {
+        size_t first = samples.size();
+        samples.resize(first + count, std::vector<double>(METRICS));
+        std::atomic<size_t> next(first);
+        auto worker = [&]() {
+            size_t r;
+            while ((r = next++) < samples.size()) {
+                std::vector<Process> processes =
+                    generateReplicationWorkload(ADAPTIVE_PROCESS_COUNT, arrival_rate, ADAPTIVE_SEED + r, false);
+                for (int k = 0; k < K; k++) {
+                    EngineResult result = simulateWorkload(processes, *makePolicy(kinds[k]));
+                    samples[r][2 * k] = result.averageWaitingTime();
+                    samples[r][2 * k + 1] = summarizeLatencies(result.turnaround_time).p95;
+                }
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (std::thread& thread : pool) thread.join();
+    };
+
+    std::vector<ConfidenceInterval> intervals(METRICS);
+    int rounds = 0;
+    int binding = 0;
+    auto start = std::chrono::steady_clock::now();
+    int next_round = ADAPTIVE_MIN_REPLICATIONS;
+    while (true) {
+        runRound(next_round);
+        rounds++;
+        int n = samples.size();
+        double worst = 0;
+        double needed = n;
+        for (int m = 0; m < METRICS; m++) {
+            std::vector<double> values(n);
+            for (int r = 0; r < n; r++) values[r] = samples[r][m];
+            intervals[m] = confidenceInterval(values);
+            double relative = intervals[m].half_width / std::fabs(intervals[m].mean);
+            if (relative > worst) {
+                worst = relative;
+                binding = m;
+            }
+            // Half-width shrinks like 1/sqrt(n): estimate the replications this metric still needs
+            needed = std::max(needed, n * (relative / target) * (relative / target));
+        }
+        if (worst <= target || n >= ADAPTIVE_MAX_REPLICATIONS) break;
+        // Early variance estimates are noisy, so never more than double the sample in one round
+        int wanted = std::min(n, static_cast<int>(std::ceil(needed)) - n);
+        next_round = std::min(ADAPTIVE_MAX_REPLICATIONS - n, std::max(threads, wanted));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    int replications = samples.size();
+
+    std::cout << "\n" << std::string(72, '=') << std::endl;
+    std::cout << "ADAPTIVE REPLICATION (target half-width " << std::fixed << std::setprecision(1)
+              << 100 * target << "% of the mean, 95% confidence)" << std::endl;
+    std::cout << std::string(72, '=') << std::endl;
+    std::cout << "Terminating runs: " << ADAPTIVE_PROCESS_COUNT << " processes from an empty system, offered load "
+              << std::setprecision(2) << ADAPTIVE_OFFERED_LOAD << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << std::setw(24) << std::left << "Metric" << std::right
+              << std::setw(12) << "Mean" << std::setw(13) << "Half-Width"
+              << std::setw(12) << "Relative" << std::setw(11) << "Status" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    for (int m = 0; m < METRICS; m++) {
+        double relative = intervals[m].half_width / std::fabs(intervals[m].mean);
+        std::cout << std::setw(24) << std::left << metricName(m) << std::right << std::setprecision(2)
+                  << std::setw(12) << intervals[m].mean << std::setw(13) << intervals[m].half_width
+                  << std::setw(11) << 100 * relative << "%"
+                  << std::setw(11) << (relative <= target ? "met" : "NOT MET") << std::endl;
+    }
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << "Stopped after " << replications << " replications in " << rounds << " rounds on "
+              << threads << " thread(s), " << std::setprecision(2) << elapsed.count() << " s" << std::endl;
+    std::cout << "Binding metric: " << metricName(binding) << std::endl;
+
+    std::cout << "\nSteady state (batch means, " << std::setprecision(0) << 100 * BATCH_WARMUP_FRACTION
+              << "% warm-up discarded)" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << std::setw(13) << std::left << "Policy" << std::right
+              << std::setw(11) << "Processes" << std::setw(9) << "Batches" << std::setw(8) << "Lag-1"
+              << std::setw(10) << "Mean WT" << std::setw(13) << "Half-Width" << std::setw(10) << "Relative" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    for (PolicyKind kind : kinds) {
+        long length = BATCH_INITIAL_PROCESSES;
+        BatchMeansResult result;
+        while (true) {
+            // The same stream extends the previous run, so lengthening reuses its prefix
+            std::vector<Process> processes = generateReplicationWorkload(length, arrival_rate, ADAPTIVE_SEED, false);
+            result = batchMeans(simulateWorkload(processes, *makePolicy(kind)).waiting_time);
+            if (result.ci.half_width <= target * std::fabs(result.ci.mean) || length >= BATCH_MAX_PROCESSES) break;
+            length = std::min(BATCH_MAX_PROCESSES, length * 2);
+        }
+        std::cout << std::setw(13) << std::left << policyKindName(kind) << std::right
+                  << std::setw(11) << length << std::setw(9) << result.batches
+                  << std::setw(8) << std::setprecision(2) << result.lag1
+                  << std::setw(10) << result.ci.mean << std::setw(13) << result.ci.half_width
+                  << std::setw(9) << 100 * result.ci.half_width / std::fabs(result.ci.mean) << "%" << std::endl;
+    }
+    std::cout << std::string(72, '=') << std::endl;
+
+    return replications;
+}
+
+/**
+ * SplitMix64: tiny, fast generator for resampling (one independent stream per chunk of resamples)
+ */
+struct SplitMix64 {
+    uint64_t state;
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    // Uniform integer in [0, n) by multiply-shift (no division)
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>(((next() >> 32) * static_cast<uint64_t>(n)) >> 32);
+    }
+};
+
+/**
+ * Outcome of the paired resampling tests on one comparison
+ */
+struct PairedTestResult {
+    double mean_difference = 0;
+    double ci_low = 0;            // 95% percentile bootstrap interval of the mean difference
+    double ci_high = 0;
+    double bootstrap_p = 1;       // Two-sided, from the bootstrap distribution centred on zero
+    double permutation_p = 1;     // Two-sided sign-flip permutation test
+    double effect_size = 0;       // Cohen's d_z: mean difference over its standard deviation
+    double superiority = 0;       // Share of replications where the difference is negative
+};
+
+/**
+ * Paired bootstrap and sign-flip permutation tests on per-replication differences
+ * Resamples are processed in fixed chunks, each with its own seeded stream, so results do not
+ * depend on the thread count; inner loops run over flat arrays without branches
+ * @param differences One paired difference (policy A minus policy B) per replication
+ * @param resamples Bootstrap resamples and permutations to draw
+ * @param threads Worker threads
+ * @return Interval, p-values and effect sizes
+ */
+PairedTestResult pairedResamplingTests(const std::vector<double>& differences, long resamples, int threads) {
+    PairedTestResult result;
+    int R = differences.size();
+    if (R < 2) return result;
+    ConfidenceInterval ci = confidenceInterval(differences);
+    result.mean_difference = ci.mean;
+    result.effect_size = ci.variance > 0 ? ci.mean / std::sqrt(ci.variance) : 0;
+    for (double d : differences) result.superiority += (d < 0) / static_cast<double>(R);
+
+    std::vector<double> centered(R);
+    for (int r = 0; r < R; r++) centered[r] = differences[r] - ci.mean;
+    double observed = std::fabs(ci.mean);
+
+    std::vector<double> bootstrap_means(resamples);
+    std::vector<long> bootstrap_extreme(threads, 0), permutation_extreme(threads, 0);
+    long chunks = (resamples + STAT_CHUNK - 1) / STAT_CHUNK;
+    std::atomic<long> next_chunk(0);
+
+    auto worker = [&](int id) {
+        std::vector<uint32_t> picks(R);
+        std::vector<double> signs(R);
+        long boot_extreme = 0, perm_extreme = 0;   // Counted locally: shared slots would false-share
+        long chunk;
+        while ((chunk = next_chunk++) < chunks) {
+            SplitMix64 rng(STAT_SEED + static_cast<uint64_t>(chunk) * 0x100000001B3ULL);
+            long end = std::min(resamples, (chunk + 1) * STAT_CHUNK);
+            for (long b = chunk * STAT_CHUNK; b < end; b++) {
+                // Bootstrap: one resample with replacement, reused for the original and centred series
+                for (int r = 0; r < R; r++) picks[r] = rng.below(R);
+                double sum = 0, centered_sum = 0;
+                for (int r = 0; r < R; r++) {
+                    sum += differences[picks[r]];
+                    centered_sum += centered[picks[r]];
+                }
+                bootstrap_means[b] = sum / R;
+                boot_extreme += std::fabs(centered_sum / R) >= observed;
+
+                // Permutation: under H0 each paired difference is equally likely to have either sign
+                uint64_t bits = 0;
+                for (int r = 0; r < R; r++) {
+                    if (r % 64 == 0) bits = rng.next();
+                    signs[r] = 1.0 - 2.0 * static_cast<double>((bits >> (r % 64)) & 1);
+                }
+                double flipped = 0;
+                for (int r = 0; r < R; r++) flipped += signs[r] * differences[r];
+                perm_extreme += std::fabs(flipped / R) >= observed;
+            }
+        }
+        bootstrap_extreme[id] = boot_extreme;
+        permutation_extreme[id] = perm_extreme;
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back(worker, t);
+    for (std::thread& thread : pool) thread.join();
+
+    long boot_count = 0, perm_count = 0;
+    for (int t = 0; t < threads; t++) {
+        boot_count += bootstrap_extreme[t];
+        perm_count += permutation_extreme[t];
+    }
+    result.bootstrap_p = (1.0 + boot_count) / (1.0 + resamples);
+    result.permutation_p = (1.0 + perm_count) / (1.0 + resamples);
+
+    std::sort(bootstrap_means.begin(), bootstrap_means.end());
+    result.ci_low = bootstrap_means[static_cast<long>(0.025 * (resamples - 1))];
+    result.ci_high = bootstrap_means[static_cast<long>(0.975 * (resamples - 1))];
+    return result;
+}
+
+/**
+ * Significance Testing of Policy Comparisons
+ * Runs paired replications (common random numbers) and tests every pair of policies
+ * with a paired bootstrap and a sign-flip permutation test, Holm-adjusted across comparisons
+ * @param replications Paired replications per policy
+ * @param resamples Bootstrap resamples and permutations per comparison
+ * @return Permutation p-value of Round Robin vs SJF
+ */
+double significance_testing(int replications, long resamples) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    double arrival_rate = STAT_OFFERED_LOAD / mean_burst;
+    int threads = std::max(1, std::min(STAT_MAX_THREADS, static_cast<int>(std::thread::hardware_concurrency())));
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    const int K = 4;
+
+    std::vector<std::vector<double>> waiting(K, std::vector<double>(replications));
+    for (int r = 0; r < replications; r++) {
+        std::vector<Process> processes =
+            generateReplicationWorkload(STAT_PROCESS_COUNT, arrival_rate, STAT_WORKLOAD_SEED + r, false);
+        for (int k = 0; k < K; k++) {
+            waiting[k][r] = simulateWorkload(processes, *makePolicy(kinds[k])).averageWaitingTime();
+        }
+    }
+
+    struct Comparison {
+        int a, b;
+        PairedTestResult test;
+        double holm_p;
+    };
+    std::vector<Comparison> comparisons;
+    auto start = std::chrono::steady_clock::now();
+    // Every policy against SJF first, then the remaining pairs (indices into kinds)
+    const int pairs[][2] = {{3, 1}, {0, 1}, {2, 1}, {3, 0}, {2, 0}, {3, 2}};
+    for (const auto& pair : pairs) {
+        std::vector<double> differences(replications);
+        for (int r = 0; r < replications; r++) differences[r] = waiting[pair[0]][r] - waiting[pair[1]][r];
+        comparisons.push_back(Comparison{pair[0], pair[1], pairedResamplingTests(differences, resamples, threads), 1});
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Holm step-down adjustment of the permutation p-values
+    std::vector<size_t> order(comparisons.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        return comparisons[x].test.permutation_p < comparisons[y].test.permutation_p;
+    });
+    double running = 0;
+    for (size_t rank = 0; rank < order.size(); rank++) {
+        Comparison& comparison = comparisons[order[rank]];
+        running = std::max(running, std::min(1.0, (order.size() - rank) * comparison.test.permutation_p));
+        comparison.holm_p = running;
+    }
+
+    std::cout << "\n" << std::string(96, '=') << std::endl;
+    std::cout << "SIGNIFICANCE TESTING (paired bootstrap and permutation, mean waiting time)" << std::endl;
+    std::cout << std::string(96, '=') << std::endl;
+    std::cout << "Replications: " << replications << " paired workloads of " << STAT_PROCESS_COUNT
+              << " processes, " << resamples << " resamples per test, " << threads << " thread(s)" << std::endl;
+    std::cout << std::string(96, '-') << std::endl;
+    std::cout << std::setw(22) << std::left << "Comparison (A - B)" << std::right
+              << std::setw(10) << "Mean Diff" << std::setw(20) << "95% Bootstrap CI"
+              << std::setw(9) << "Boot p" << std::setw(9) << "Perm p" << std::setw(9) << "Holm p"
+              << std::setw(9) << "d_z" << std::setw(8) << "A<B" << std::endl;
+    std::cout << std::string(96, '-') << std::endl;
+    double rr_vs_sjf = 1;
+    for (const Comparison& comparison : comparisons) {
+        const PairedTestResult& test = comparison.test;
+        std::ostringstream label, interval;
+        label << policyKindName(kinds[comparison.a]) << " - " << policyKindName(kinds[comparison.b]);
+        interval << std::fixed << std::setprecision(2) << "[" << test.ci_low << ", " << test.ci_high << "]";
+        std::cout << std::setw(22) << std::left << label.str() << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(10) << test.mean_difference << std::setw(20) << interval.str()
+                  << std::setprecision(5) << std::setw(9) << test.bootstrap_p << std::setw(9) << test.permutation_p
+                  << std::setw(9) << comparison.holm_p << std::setprecision(2) << std::setw(9) << test.effect_size
+                  << std::setw(7) << std::setprecision(0) << 100 * test.superiority << "%"
+                  << (comparison.holm_p < 0.05 ? " *" : "") << std::endl;
+        if (kinds[comparison.a] == POLICY_RR && kinds[comparison.b] == POLICY_SJF) {
+            rr_vs_sjf = test.permutation_p;
+        }
+    }
+    std::cout << std::string(96, '-') << std::endl;
+    std::cout << "* significant at 5% after Holm correction; d_z = mean difference / SD of differences;" << std::endl;
+    std::cout << "A<B = replications where A waited less. Smallest attainable p = " << std::setprecision(5)
+              << 1.0 / (1 + resamples) << "; tests took " << std::setprecision(2) << elapsed.count() << " s" << std::endl;
+    std::cout << std::string(96, '=') << std::endl;
+
+    return rr_vs_sjf;
+}
+
+/**
+ * Shared library holding a policy plugin; closed when the last policy using it is destroyed
+ */
+class PluginLibrary {
+public:
+    /**
+     * Opens a shared library
+     * @param path Library path
+     * @param error Receives the loader's message on failure
+     */
+    PluginLibrary(const std::string& path, std::string& error) {
+#ifdef _WIN32
+        handle = LoadLibraryA(path.c_str());
+        if (!handle) error = "LoadLibrary failed with error " + std::to_string(GetLastError());
+#else
+        handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) error = dlerror();
+#endif
+    }
+    ~PluginLibrary() {
+        if (!handle) return;
+#ifdef _WIN32
+        FreeLibrary(handle);
+#else
+        dlclose(handle);
+#endif
+    }
+    PluginLibrary(const PluginLibrary&) = delete;
+    PluginLibrary& operator=(const PluginLibrary&) = delete;
+
+    bool isOpen() const { return handle != nullptr; }
+
+    void* symbol(const char* name) const {
+#ifdef _WIN32
+        return reinterpret_cast<void*>(GetProcAddress(handle, name));
+#else
+        return dlsym(handle, name);
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HMODULE handle = nullptr;
+#else
+    void* handle = nullptr;
+#endif
+};
+
+/**
+ * Engine policy backed by a plugin through the C ABI in scheduler_plugin.h
+ * Events between two decisions are buffered and delivered in one batch per kind before
+ * the plugin is asked for its next pick, so the boundary is crossed a few times per decision
+ */
+class PluginPolicy : public SchedulerPolicy {
+public:
+    PluginPolicy(std::shared_ptr<PluginLibrary> library, const sched_plugin_api* api, void* state)
+        : library(library), api(api), state(state) {}
+    ~PluginPolicy() override {
+        if (api->destroy) api->destroy(state);
+    }
+
+    std::string name() const override { return api->name ? api->name : "Plugin"; }
+
+    void enqueue(const ReadyProcess& process, double now) override {
+        pending_tasks.push_back(sched_task{process.index, process.pid, process.priority, process.burst_time,
+                                           process.arrival_time, process.remaining});
+        pending_now = now;
+        queued++;
+        if (process.index >= static_cast<int>(in_plugin.size())) in_plugin.resize(process.index + 1, false);
+        in_plugin[process.index] = true;
+    }
+
+    // The plugin's answer is checked against the indices handed to it before the engine uses it
+    int pickNext(double now) override {
+        if (error) return -1;
+        flush();
+        boundary_calls++;
+        int index = api->pick_next(state, now);
+        decisions++;
+        if (index == -1) {
+            if (queued > 0 && nextEligibleTime(now) <= now) {
+                fail("returned no process with " + std::to_string(queued) + " queued and no later eligible time");
+            }
+            return -1;
+        }
+        if (index < 0 || index >= static_cast<int>(in_plugin.size()) || !in_plugin[index]) {
+            fail("returned index " + std::to_string(index) + ", which is not queued");
+            return -1;
+        }
+        in_plugin[index] = false;
+        queued--;
+        return index;
+    }
+
+    bool failed() const override { return error; }
+
+    bool empty() const override { return queued == 0; }
+
+    double timeSlice(int index, double now) override {
+        if (!api->time_slice) return api->default_time_slice;
+        boundary_calls++;
+        return api->time_slice(state, index, now);
+    }
+
+    void onTick(int index, double ran, double now) override {
+        pending_ticks.push_back(sched_tick{index, ran, now});
+    }
+
+    void onComplete(int index, double now) override {
+        pending_completions.push_back(sched_completion{index, now});
+    }
+
+    double nextEligibleTime(double now) const override {
+        if (!api->next_eligible_time) return now;
+        return api->next_eligible_time(state, now);
+    }
+
+    long boundaryCalls() const { return boundary_calls; }
+    long decisionCount() const { return decisions; }
+
+private:
+    void fail(const std::string& reason) {
+        std::cout << name() << ": plugin " << reason << "; stopping the run" << std::endl;
+        error = true;
+    }
+
+    // Delivers buffered events: ticks, then completions, then newly ready processes
+    void flush() {
+        if (!pending_ticks.empty()) {
+            api->on_tick(state, pending_ticks.data(), pending_ticks.size());
+            pending_ticks.clear();
+            boundary_calls++;
+        }
+        if (!pending_completions.empty()) {
+            api->on_complete(state, pending_completions.data(), pending_completions.size());
+            pending_completions.clear();
+            boundary_calls++;
+        }
+        if (!pending_tasks.empty()) {
+            api->enqueue(state, pending_tasks.data(), pending_tasks.size(), pending_now);
+            pending_tasks.clear();
+            boundary_calls++;
+        }
+    }
+
+    std::shared_ptr<PluginLibrary> library;
+    const sched_plugin_api* api;
+    void* state = nullptr;
+    std::vector<sched_task> pending_tasks;
+    std::vector<sched_tick> pending_ticks;
+    std::vector<sched_completion> pending_completions;
+    double pending_now = 0;
+    long queued = 0;
+    std::vector<bool> in_plugin;   // Indices the plugin holds and may return
+    bool error = false;
+    long boundary_calls = 0;
+    long decisions = 0;
+};
+
+/**
+ * Loads a policy plugin from a shared library
+ * The path may carry plugin options after '?', e.g. "plugins/hrrn_policy.so?aging=2"
+ * @param spec Library path with optional options
+ * @param policy Receives the policy on success
+ * @return true on success; errors are printed
+ */
+bool loadPolicyPlugin(const std::string& spec, std::unique_ptr<SchedulerPolicy>& policy) {
+    size_t question = spec.find('?');
+    std::string path = spec.substr(0, question);
+    std::string options = question == std::string::npos ? "" : spec.substr(question + 1);
+
+    std::string error;
+    std::shared_ptr<PluginLibrary> library = std::make_shared<PluginLibrary>(path, error);
+    if (!library->isOpen()) {
+        std::cout << path << ": cannot load plugin (" << error << ")" << std::endl;
+        return false;
+    }
+    void* entry = library->symbol(SCHED_PLUGIN_ENTRY_SYMBOL);
+    if (!entry) {
+        std::cout << path << ": missing entry point " << SCHED_PLUGIN_ENTRY_SYMBOL << std::endl;
+        return false;
+    }
+    const sched_plugin_api* api = reinterpret_cast<sched_plugin_entry_fn>(entry)();
+    if (!api || api->abi_version != SCHED_PLUGIN_ABI_VERSION) {
+        std::cout << path << ": plugin ABI version " << (api ? api->abi_version : 0)
+                  << " does not match " << SCHED_PLUGIN_ABI_VERSION << std::endl;
+        return false;
+    }
+    if (!api->init || !api->enqueue || !api->on_tick || !api->on_complete || !api->pick_next) {
+        std::cout << path << ": plugin is missing a required callback" << std::endl;
+        return false;
+    }
+    void* state = api->init(options.c_str());
+    if (!state) {
+        std::cout << path << ": plugin init failed" << (options.empty() ? "" : " for options " + options) << std::endl;
+        return false;
+    }
+    policy.reset(new PluginPolicy(library, api, state));
+    return true;
+}
+
+/**
+ * Plugin Policy Comparison
+ * Runs a plugin policy next to the built-in ones on the same arrival workload
+ * @param spec Plugin path with optional options
+ * @return Average waiting time under the plugin (negative if it could not be loaded or failed)
+ */
+double plugin_policy_comparison(const std::string& spec) {
+    std::unique_ptr<SchedulerPolicy> plugin;
+    if (!loadPolicyPlugin(spec, plugin)) {
+        return -1;
+    }
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    std::vector<Process> processes =
+        generateArrivalWorkload(PLUGIN_PROCESS_COUNT, PLUGIN_OFFERED_LOAD / mean_burst, PLUGIN_SEED);
+
+    std::cout << "\n" << std::string(76, '=') << std::endl;
+    std::cout << "PLUGIN POLICY: " << plugin->name() << " (ABI v" << SCHED_PLUGIN_ABI_VERSION << ")" << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+    std::cout << "Workload: " << PLUGIN_PROCESS_COUNT << " Poisson arrivals, offered load " << PLUGIN_OFFERED_LOAD << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << std::setw(18) << std::left << "Policy" << std::right
+              << std::setw(9) << "Avg WT" << std::setw(9) << "p99 WT" << std::setw(10) << "Avg TAT"
+              << std::setw(10) << "Sim ms" << std::setw(10) << "ns/Dec" << std::setw(10) << "Calls/Dec" << std::endl;
+    std::cout << std::string(76, '-') << std::endl;
+
+    auto report = [&](SchedulerPolicy& policy, PluginPolicy* adapter) {
+        auto start = std::chrono::steady_clock::now();
+        EngineResult result = simulateWorkload(processes, policy);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (result.aborted) {
+            std::cout << std::setw(18) << std::left << policy.name() << std::right << "  run stopped (plugin error)" << std::endl;
+            return -1.0;
+        }
+        LatencySummary wait = summarizeLatencies(result.waiting_time);
+        LatencySummary turnaround = summarizeLatencies(result.turnaround_time);
+        std::cout << std::setw(18) << std::left << policy.name() << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << wait.mean << std::setw(9) << wait.p99 << std::setw(10) << turnaround.mean
+                  << std::setw(10) << elapsed.count() * 1e3
+                  << std::setw(10) << std::setprecision(0) << elapsed.count() * 1e9 / std::max(1L, result.dispatches);
+        if (adapter) {
+            std::cout << std::setw(10) << std::setprecision(2)
+                      << static_cast<double>(adapter->boundaryCalls()) / std::max(1L, adapter->decisionCount());
+        } else {
+            std::cout << std::setw(10) << "-";
+        }
+        std::cout << std::endl;
+        return wait.mean;
+    };
+
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    for (PolicyKind kind : kinds) {
+        report(*makePolicy(kind), nullptr);
+    }
+    double plugin_wait = report(*plugin, static_cast<PluginPolicy*>(plugin.get()));
+    std::cout << std::string(76, '-') << std::endl;
+    std::cout << "ns/Dec: simulation time per scheduling decision; Calls/Dec: plugin calls per decision" << std::endl;
+    std::cout << std::string(76, '=') << std::endl;
+
+    return plugin_wait;
+}
+
+/**
+ * Per-process values a policy expression can read
+ */
+enum DslVariable {
+    DSL_PRIORITY,    // priority: lower number = higher priority
+    DSL_BURST,       // burst: total CPU time required
+    DSL_REMAINING,   // remaining: CPU time still required
+    DSL_ARRIVAL,     // arrival: arrival time
+    DSL_AGE,         // age: now - arrival
+    DSL_WAIT,        // wait: time since the process last became ready
+    DSL_RUN,         // run: time run since the current dispatch (preemption conditions)
+    DSL_NOW,         // now: current time
+    DSL_VARIABLE_COUNT
+};
+
+const char* const DSL_VARIABLE_NAMES[DSL_VARIABLE_COUNT] = {
+    "priority", "burst", "remaining", "arrival", "age", "wait", "run", "now"
+};
+
+/**
+ * Register bytecode operations; every operation applies to a whole batch of processes
+ */
+enum DslOp : uint8_t {
+    DSL_LOADK, DSL_LOADV,
+    DSL_ADD, DSL_SUB, DSL_MUL, DSL_DIV, DSL_MIN, DSL_MAX,
+    DSL_LT, DSL_LE, DSL_GT, DSL_GE, DSL_EQ, DSL_NE, DSL_AND, DSL_OR,
+    DSL_NEG, DSL_ABS, DSL_NOT
+};
+
+struct DslInstruction {
+    DslOp op;
+    uint8_t dst;
+    uint8_t a;   // Register, variable (LOADV) or constant pool slot (LOADK)
+    uint8_t b;
+};
+
+/**
+ * Compiled expression: instructions plus constant pool; the result ends in register 0
+ */
+struct DslProgram {
+    std::vector<DslInstruction> code;
+    std::vector<double> constants;
+    int registers = 0;
+    bool empty() const { return code.empty(); }
+};
+
+/**
+ * Recursive-descent compiler from the policy expression language to register bytecode
+ *   expr    := or
+ *   or      := and ('||' and)*          and := compare ('&&' compare)*
+ *   compare := sum (('<'|'<='|'>'|'>='|'=='|'!=') sum)?
+ *   sum     := product (('+'|'-') product)*
+ *   product := unary (('*'|'/') unary)*
+ *   unary   := ('-'|'!') unary | primary
+ *   primary := number | variable | min(e,e) | max(e,e) | abs(e) | '(' expr ')'
+ * Registers are allocated like a stack, so an operand's register is freed as soon as it is consumed
+ */
+class DslCompiler {
+public:
+    /**
+     * Compiles one expression
+     * @param source Expression text
+     * @param program Receives the bytecode
+     * @param error Receives a message with the column of the problem on failure
+     * @return true on success
+     */
+    bool compile(const std::string& source, DslProgram& program, std::string& error) {
+        text = source;
+        position = 0;
+        next_register = 0;
+        out = DslProgram();
+        message.clear();
+        int result = parseOr();
+        skipSpace();
+        if (message.empty() && position != text.size()) fail("unexpected '" + text.substr(position, 1) + "'");
+        if (!message.empty()) {
+            error = message;
+            return false;
+        }
+        (void)result;   // Always register 0: the first register allocated
+        program = out;
+        return true;
+    }
+
+private:
+    void fail(const std::string& what) {
+        if (message.empty()) message = "column " + std::to_string(position + 1) + ": " + what;
+    }
+
+    void skipSpace() {
+        while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) position++;
+    }
+
+    bool accept(const std::string& token) {
+        skipSpace();
+        if (text.compare(position, token.size(), token) == 0) {
+            position += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    int allocate() {
+        if (next_register >= DSL_MAX_REGISTERS) {
+            fail("expression too deep");
+            return 0;
+        }
+        out.registers = std::max(out.registers, next_register + 1);
+        return next_register++;
+    }
+
+    int emit(DslOp op, int a, int b = 0) {
+        // Binary results overwrite the left operand and release the right one
+        if (op >= DSL_ADD && op <= DSL_OR) {
+            out.code.push_back(DslInstruction{op, static_cast<uint8_t>(a), static_cast<uint8_t>(a), static_cast<uint8_t>(b)});
+            next_register = b;
+            return a;
+        }
+        out.code.push_back(DslInstruction{op, static_cast<uint8_t>(a), static_cast<uint8_t>(a), 0});
+        return a;
+    }
+
+    int parseOr() {
+        int left = parseAnd();
+        while (message.empty() && accept("||")) left = emit(DSL_OR, left, parseAnd());
+        return left;
+    }
+
+    int parseAnd() {
+        int left = parseCompare();
+        while (message.empty() && accept("&&")) left = emit(DSL_AND, left, parseCompare());
+        return left;
+    }
+
+    int parseCompare() {
+        int left = parseSum();
+        const std::pair<const char*, DslOp> operators[] = {
+            {"<=", DSL_LE}, {">=", DSL_GE}, {"==", DSL_EQ}, {"!=", DSL_NE}, {"<", DSL_LT}, {">", DSL_GT}
+        };
+        for (const auto& candidate : operators) {
+            if (message.empty() && accept(candidate.first)) return emit(candidate.second, left, parseSum());
+        }
+        return left;
+    }
+
+    int parseSum() {
+        int left = parseProduct();
+        while (message.empty()) {
+            if (accept("+")) left = emit(DSL_ADD, left, parseProduct());
+            else if (accept("-")) left = emit(DSL_SUB, left, parseProduct());
+            else break;
+        }
+        return left;
+    }
+
+    int parseProduct() {
+        int left = parseUnary();
+        while (message.empty()) {
+            if (accept("*")) left = emit(DSL_MUL, left, parseUnary());
+            else if (accept("/")) left = emit(DSL_DIV, left, parseUnary());
+            else break;
+        }
+        return left;
+    }
+
+    int parseUnary() {
+        if (accept("-")) return emit(DSL_NEG, parseUnary());
+        if (accept("!")) return emit(DSL_NOT, parseUnary());
+        return parsePrimary();
+    }
+
+    int parsePrimary() {
+        skipSpace();
+        if (position >= text.size()) {
+            fail("unexpected end of expression");
+            return 0;
+        }
+        if (accept("(")) {
+            int inner = parseOr();
+            if (!accept(")")) fail("expected ')'");
+            return inner;
+        }
+        char c = text[position];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            size_t length = 0;
+            double value = 0;
+            try {
+                value = std::stod(text.substr(position), &length);
+            } catch (const std::exception&) {
+                fail("malformed number");
+                return 0;
+            }
+            position += length;
+            int slot = out.constants.size();
+            if (slot > 255) {
+                fail("too many constants");
+                return 0;
+            }
+            out.constants.push_back(value);
+            int reg = allocate();
+            out.code.push_back(DslInstruction{DSL_LOADK, static_cast<uint8_t>(reg), static_cast<uint8_t>(slot), 0});
+            return reg;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            size_t start = position;
+            while (position < text.size() && (std::isalnum(static_cast<unsigned char>(text[position])) || text[position] == '_')) {
+                position++;
+            }
+            std::string word = text.substr(start, position - start);
+            if (word == "min" || word == "max") {
+                if (!accept("(")) fail("expected '(' after " + word);
+                int a = parseOr();
+                if (!accept(",")) fail("expected ','");
+                int b = parseOr();
+                if (!accept(")")) fail("expected ')'");
+                return emit(word == "min" ? DSL_MIN : DSL_MAX, a, b);
+            }
+            if (word == "abs") {
+                if (!accept("(")) fail("expected '(' after abs");
+                int a = parseOr();
+                if (!accept(")")) fail("expected ')'");
+                return emit(DSL_ABS, a);
+            }
+            for (int v = 0; v < DSL_VARIABLE_COUNT; v++) {
+                if (word == DSL_VARIABLE_NAMES[v]) {
+                    int reg = allocate();
+                    out.code.push_back(DslInstruction{DSL_LOADV, static_cast<uint8_t>(reg), static_cast<uint8_t>(v), 0});
+                    return reg;
+                }
+            }
+            position = start;
+            fail("unknown name '" + word + "'");
+            return 0;
+        }
+        fail("unexpected '" + std::string(1, c) + "'");
+        return 0;
+    }
+
+    std::string text;
+    size_t position = 0;
+    int next_register = 0;
+    DslProgram out;
+    std::string message;
+};
+
+/**
+ * Ready processes stored column by column (structure of arrays)
+ */
+struct DslColumns {
+    std::vector<int> index;
+    std::vector<double> priority, burst, remaining, arrival, ready_since;
+
+    size_t size() const { return index.size(); }
+
+    void push(const ReadyProcess& process, double now) {
+        index.push_back(process.index);
+        priority.push_back(process.priority);
+        burst.push_back(process.burst_time);
+        remaining.push_back(process.remaining);
+        arrival.push_back(process.arrival_time);
+        ready_since.push_back(now);
+    }
+
+    void clear() {
+        index.clear(); priority.clear(); burst.clear(); remaining.clear(); arrival.clear(); ready_since.clear();
+    }
+
+    // Removes row i by moving the last row into its place
+    void remove(size_t i) {
+        index[i] = index.back(); index.pop_back();
+        priority[i] = priority.back(); priority.pop_back();
+        burst[i] = burst.back(); burst.pop_back();
+        remaining[i] = remaining.back(); remaining.pop_back();
+        arrival[i] = arrival.back(); arrival.pop_back();
+        ready_since[i] = ready_since.back(); ready_since.pop_back();
+    }
+};
+
+/**
+ * Batch interpreter: each instruction runs over up to DSL_BATCH rows before the next is decoded,
+ * so dispatch cost is amortized and the inner loops are plain array arithmetic
+ */
+class DslMachine {
+public:
+    /**
+     * Evaluates a program for rows [first, first + count) of the columns
+     * @param run Time run in the current dispatch (value of 'run' for every row)
+     * @param out Receives count results
+     */
+    void evaluate(const DslProgram& program, const DslColumns& columns, size_t first, size_t count,
+                  double now, double run, double* out) {
+        for (const DslInstruction& ins : program.code) {
+            double* d = registers[ins.dst];
+            const double* a = registers[ins.a];
+            const double* b = registers[ins.b];
+            switch (ins.op) {
+                case DSL_LOADK: {
+                    double k = program.constants[ins.a];
+                    for (size_t i = 0; i < count; i++) d[i] = k;
+                    break;
+                }
+                case DSL_LOADV:
+                    loadVariable(static_cast<DslVariable>(ins.a), columns, first, count, now, run, d);
+                    break;
+                case DSL_ADD: for (size_t i = 0; i < count; i++) d[i] = a[i] + b[i]; break;
+                case DSL_SUB: for (size_t i = 0; i < count; i++) d[i] = a[i] - b[i]; break;
+                case DSL_MUL: for (size_t i = 0; i < count; i++) d[i] = a[i] * b[i]; break;
+                case DSL_DIV: for (size_t i = 0; i < count; i++) d[i] = a[i] / b[i]; break;
+                case DSL_MIN: for (size_t i = 0; i < count; i++) d[i] = std::min(a[i], b[i]); break;
+                case DSL_MAX: for (size_t i = 0; i < count; i++) d[i] = std::max(a[i], b[i]); break;
+                case DSL_LT: for (size_t i = 0; i < count; i++) d[i] = a[i] < b[i]; break;
+                case DSL_LE: for (size_t i = 0; i < count; i++) d[i] = a[i] <= b[i]; break;
+                case DSL_GT: for (size_t i = 0; i < count; i++) d[i] = a[i] > b[i]; break;
+                case DSL_GE: for (size_t i = 0; i < count; i++) d[i] = a[i] >= b[i]; break;
+                case DSL_EQ: for (size_t i = 0; i < count; i++) d[i] = a[i] == b[i]; break;
+                case DSL_NE: for (size_t i = 0; i < count; i++) d[i] = a[i] != b[i]; break;
+                case DSL_AND: for (size_t i = 0; i < count; i++) d[i] = (a[i] != 0) & (b[i] != 0); break;
+                case DSL_OR: for (size_t i = 0; i < count; i++) d[i] = (a[i] != 0) | (b[i] != 0); break;
+                case DSL_NEG: for (size_t i = 0; i < count; i++) d[i] = -a[i]; break;
+                case DSL_ABS: for (size_t i = 0; i < count; i++) d[i] = std::fabs(a[i]); break;
+                case DSL_NOT: for (size_t i = 0; i < count; i++) d[i] = a[i] == 0; break;
+            }
+        }
+        std::copy(registers[0], registers[0] + count, out);
+    }
+
+private:
+    static void loadVariable(DslVariable variable, const DslColumns& columns, size_t first, size_t count,
+                             double now, double run, double* d) {
+        switch (variable) {
+            case DSL_PRIORITY: std::copy_n(&columns.priority[first], count, d); break;
+            case DSL_BURST: std::copy_n(&columns.burst[first], count, d); break;
+            case DSL_REMAINING: std::copy_n(&columns.remaining[first], count, d); break;
+            case DSL_ARRIVAL: std::copy_n(&columns.arrival[first], count, d); break;
+            case DSL_AGE: for (size_t i = 0; i < count; i++) d[i] = now - columns.arrival[first + i]; break;
+            case DSL_WAIT: for (size_t i = 0; i < count; i++) d[i] = now - columns.ready_since[first + i]; break;
+            case DSL_RUN: std::fill_n(d, count, run); break;
+            case DSL_NOW: std::fill_n(d, count, now); break;
+            case DSL_VARIABLE_COUNT: break;
+        }
+    }
+
+    double registers[DSL_MAX_REGISTERS][DSL_BATCH];
+};
+
+/**
+ * Policy defined by expressions: the ready process with the highest key runs next and,
+ * if a preemption condition is given, the running process is checked every
+ * DSL_PREEMPT_CHECK time units and keeps the CPU while the condition is false.
+ * Key and condition can instead be native functions, to measure the interpreter's overhead
+ */
+class DslPolicy : public SchedulerPolicy {
+public:
+    typedef void (*NativeKey)(const DslColumns&, size_t first, size_t count, double now, double* out);
+    typedef bool (*NativeCondition)(double remaining, double run, double now);
+
+    DslPolicy(const std::string& label, const DslProgram& key, const DslProgram& preempt)
+        : label(label), key(key), preempt(preempt), has_preempt(!preempt.empty()) {}
+
+    DslPolicy(const std::string& label, NativeKey native_key, NativeCondition native_preempt)
+        : label(label), native_key(native_key), native_preempt(native_preempt), has_preempt(native_preempt != nullptr) {}
+
+    std::string name() const override { return label; }
+
+    void enqueue(const ReadyProcess& process, double now) override {
+        if (process.index == running && has_preempt && !shouldPreempt(process.remaining, now)) {
+            continuing = process.index;   // Condition false: keeps the CPU at the next pick
+            return;
+        }
+        ready.push(process, now);
+    }
+
+    int pickNext(double now) override {
+        if (continuing != -1) {
+            int index = continuing;
+            continuing = -1;
+            return index;
+        }
+        if (ready.size() == 0) return -1;
+        size_t best = 0;
+        double best_key = -std::numeric_limits<double>::infinity();
+        double keys[DSL_BATCH];
+        for (size_t first = 0; first < ready.size(); first += DSL_BATCH) {
+            size_t count = std::min(static_cast<size_t>(DSL_BATCH), ready.size() - first);
+            if (native_key) native_key(ready, first, count, now, keys);
+            else machine.evaluate(key, ready, first, count, now, 0, keys);
+            for (size_t i = 0; i < count; i++) {
+                if (keys[i] > best_key) {
+                    best_key = keys[i];
+                    best = first + i;
+                }
+            }
+        }
+        running = ready.index[best];
+        run = 0;
+        if (has_preempt) {
+            current.clear();
+            current.push(ReadyProcess{running, 0, static_cast<int>(ready.priority[best]), static_cast<int>(ready.burst[best]),
+                                      ready.arrival[best], ready.remaining[best]}, ready.ready_since[best]);
+        }
+        ready.remove(best);
+        return running;
+    }
+
+    bool empty() const override { return ready.size() == 0 && continuing == -1; }
+
+    double timeSlice(int index, double now) override {
+        (void)index;
+        (void)now;
+        return has_preempt ? DSL_PREEMPT_CHECK : 0;
+    }
+
+    void onTick(int index, double ran, double now) override {
+        (void)now;
+        if (index == running) run += ran;
+    }
+
+    void onComplete(int index, double now) override {
+        (void)now;
+        if (index == running) running = -1;
+    }
+
+private:
+    bool shouldPreempt(double remaining, double now) {
+        if (native_preempt) return native_preempt(remaining, run, now);
+        current.remaining[0] = remaining;
+        double result;
+        machine.evaluate(preempt, current, 0, 1, now, run, &result);
+        return result != 0;
+    }
+
+    std::string label;
+    DslProgram key, preempt;
+    NativeKey native_key = nullptr;
+    NativeCondition native_preempt = nullptr;
+    bool has_preempt;
+    DslColumns ready;
+    DslColumns current;   // Running process as a one-row batch, updated on dispatch
+    DslMachine machine;
+    int running = -1;
+    int continuing = -1;
+    double run = 0;
+};
+
+// Native versions of the default expressions, for the overhead comparison
+void nativeDefaultKey(const DslColumns& columns, size_t first, size_t count, double now, double* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = -columns.priority[first + i] + (now - columns.arrival[first + i]) / 10
+                 - columns.remaining[first + i] / 4;
+    }
+}
+
+bool nativeDefaultPreempt(double remaining, double run, double now) {
+    (void)now;
+    return run >= 4 && remaining > 1;
+}
+
+/**
+ * Policy DSL Experiment
+ * Compiles a selection key and an optional preemption condition, runs the resulting policy
+ * next to the built-in ones and reports the interpreter's cost per decision
+ * @param key_source Key expression (highest key runs first)
+ * @param preempt_source Preemption condition, or empty to run processes to completion
+ * @return Average waiting time under the compiled policy (negative on a compile error)
+ */
+double policy_dsl_experiment(const std::string& key_source, const std::string& preempt_source) {
+    DslCompiler compiler;
+    DslProgram key, preempt;
+    std::string error;
+    if (!compiler.compile(key_source, key, error)) {
+        std::cout << "Key expression: " << error << std::endl;
+        return -1;
+    }
+    if (!preempt_source.empty() && !compiler.compile(preempt_source, preempt, error)) {
+        std::cout << "Preemption condition: " << error << std::endl;
+        return -1;
+    }
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    std::vector<Process> processes = generateArrivalWorkload(DSL_PROCESS_COUNT, DSL_OFFERED_LOAD / mean_burst, DSL_SEED);
+
+    std::cout << "\n" << std::string(72, '=') << std::endl;
+    std::cout << "POLICY DSL" << std::endl;
+    std::cout << std::string(72, '=') << std::endl;
+    std::cout << "Key (highest first): " << key_source << "  [" << key.code.size() << " instructions, "
+              << key.registers << " registers]" << std::endl;
+    std::cout << "Preempt when:        " << (preempt_source.empty() ? "never" : preempt_source);
+    if (!preempt.empty()) std::cout << "  [" << preempt.code.size() << " instructions]";
+    std::cout << std::endl;
+    std::cout << "Workload: " << DSL_PROCESS_COUNT << " Poisson arrivals, offered load " << DSL_OFFERED_LOAD << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << std::setw(20) << std::left << "Policy" << std::right
+              << std::setw(9) << "Avg WT" << std::setw(9) << "p99 WT" << std::setw(10) << "Avg TAT"
+              << std::setw(10) << "Switches" << std::setw(10) << "ns/Dec" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+
+    auto report = [&](SchedulerPolicy& policy) {
+        auto start = std::chrono::steady_clock::now();
+        EngineResult result = simulateWorkload(processes, policy);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        LatencySummary wait = summarizeLatencies(result.waiting_time);
+        double per_decision = elapsed.count() * 1e9 / std::max(1L, result.dispatches);
+        std::cout << std::setw(20) << std::left << policy.name() << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << wait.mean << std::setw(9) << wait.p99
+                  << std::setw(10) << summarizeLatencies(result.turnaround_time).mean
+                  << std::setw(10) << result.context_switches
+                  << std::setw(10) << std::setprecision(0) << per_decision << std::endl;
+        return std::make_pair(wait.mean, per_decision);
+    };
+
+    const PolicyKind kinds[] = {POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    for (PolicyKind kind : kinds) {
+        report(*makePolicy(kind));
+    }
+    DslPolicy compiled("DSL (bytecode)", key, preempt);
+    std::pair<double, double> interpreted = report(compiled);
+
+    if (key_source == DSL_DEFAULT_KEY && preempt_source == DSL_DEFAULT_PREEMPT) {
+        DslPolicy native("DSL (native C++)", nativeDefaultKey, nativeDefaultPreempt);
+        std::pair<double, double> baseline = report(native);
+        std::cout << std::string(72, '-') << std::endl;
+        std::cout << "Bytecode cost per decision: " << std::setprecision(2)
+                  << interpreted.second / baseline.second << "x the native policy" << std::endl;
+    }
+    std::cout << std::string(72, '=') << std::endl;
+
+    return interpreted.first;
+}
+
+/**
+ * Workload classes the policy search tunes for
+ */
+enum WorkloadClass {
+    WORKLOAD_INTERACTIVE,   // Mostly short bursts with a few long jobs
+    WORKLOAD_BATCH,         // Long bursts
+    WORKLOAD_MIXED          // Uniform bursts (the default generator)
+};
+
+const char* workloadClassName(WorkloadClass workload) {
+    switch (workload) {
+        case WORKLOAD_INTERACTIVE: return "Interactive";
+        case WORKLOAD_BATCH: return "Batch";
+        case WORKLOAD_MIXED: return "Mixed";
+    }
+    return "Unknown";
+}
+
+/**
+ * Generates a Poisson-arrival workload of one class at the given offered load
+ * @param workload Burst-time distribution to draw from
+ * @param num_processes Number of processes to generate
+ * @param load Offered load (arrival rate times mean burst)
+ * @param seed Random seed
+ * @return Vector of processes in arrival order
+ */
+std::vector<Process> generateClassWorkload(WorkloadClass workload, int num_processes, double load, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> priority(MIN_PRIORITY, MAX_PRIORITY);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    double mean_burst;
+    switch (workload) {
+        case WORKLOAD_INTERACTIVE: mean_burst = 0.9 * 2 + 0.1 * 40; break;   // 90% in [1,3], 10% in [20,60]
+        case WORKLOAD_BATCH: mean_burst = 25; break;                         // Uniform in [10,40]
+        default: mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0; break;
+    }
+    std::exponential_distribution<double> interarrival(load / mean_burst);
+    std::vector<Process> processes;
+
+    double time = 0;
+    for (int i = 0; i < num_processes; i++) {
+        time += interarrival(rng);
+        int burst_time;
+        if (workload == WORKLOAD_INTERACTIVE) {
+            burst_time = coin(rng) < 0.9 ? std::uniform_int_distribution<int>(1, 3)(rng)
+                                         : std::uniform_int_distribution<int>(20, 60)(rng);
+        } else if (workload == WORKLOAD_BATCH) {
+            burst_time = std::uniform_int_distribution<int>(10, 40)(rng);
+        } else {
+            burst_time = std::uniform_int_distribution<int>(MIN_BURST_TIME, MAX_BURST_TIME)(rng);
+        }
+        processes.emplace_back(i, burst_time, priority(rng), time);
+    }
+
+    return processes;
+}
+
+/**
+ * Knobs of the tunable multilevel feedback policy
+ */
+struct PolicyParameters {
+    int levels;               // Feedback levels (1 = single weighted round robin queue)
+    double base_quantum;      // Quantum of the top level
+    double quantum_growth;    // Each level's quantum is this multiple of the one above
+    double boost_wait;        // Waiting this long moves a process back to the top level
+    double priority_weight;   // Selection key weights within a level (lowest key runs first):
+    double size_weight;       //   priority_weight * priority + size_weight * remaining
+    double age_weight;        //   - age_weight * waiting time
+};
+
+const int TUNE_GENES = 7;
+
+/**
+ * Maps a genome in [0,1]^TUNE_GENES onto parameter ranges
+ * @param genes Genome
+ * @return Decoded parameters
+ */
+PolicyParameters decodeGenome(const std::vector<double>& genes) {
+    PolicyParameters p;
+    p.levels = 1 + std::min(3, static_cast<int>(genes[0] * 4));
+    p.base_quantum = 1 + genes[1] * 15;
+    p.quantum_growth = 1 + genes[2] * 3;
+    p.boost_wait = 10 * std::pow(100.0, genes[3]);   // 10 to 1000, log scale
+    p.priority_weight = genes[4] * 10;
+    p.size_weight = genes[5];
+    p.age_weight = genes[6] * 0.5;
+    return p;
+}
+
+std::string formatParameters(const PolicyParameters& p) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "L=" << p.levels << " q=" << p.base_quantum << "x" << p.quantum_growth
+        << " boost=" << std::setprecision(0) << p.boost_wait << std::setprecision(2)
+        << " w=(" << p.priority_weight << "," << p.size_weight << "," << p.age_weight << ")";
+    return out.str();
+}
+
+/**
+ * Multilevel feedback policy driven by PolicyParameters
+ * A process that uses its whole quantum drops one level; waiting boost_wait promotes it to the top.
+ * The highest non-empty level runs, and within it the process with the lowest weighted key
+ */
+class TunablePolicy : public SchedulerPolicy {
+public:
+    explicit TunablePolicy(const PolicyParameters& parameters) : parameters(parameters), levels(parameters.levels) {}
+
+    std::string name() const override { return "Tuned MLFQ"; }
+
+    void enqueue(const ReadyProcess& process, double now) override {
+        if (process.index >= static_cast<int>(level_of.size())) level_of.resize(process.index + 1, 0);
+        levels[level_of[process.index]].push_back(Entry{process.index, static_cast<double>(process.priority), process.remaining, now});
+        queued++;
+    }
+
+    int pickNext(double now) override {
+        if (queued == 0) return -1;
+        for (size_t level = 1; level < levels.size(); level++) {
+            std::vector<Entry>& queue = levels[level];
+            for (size_t i = 0; i < queue.size();) {
+                if (now - queue[i].ready_since >= parameters.boost_wait) {
+                    level_of[queue[i].index] = 0;
+                    levels[0].push_back(queue[i]);
+                    queue[i] = queue.back();
+                    queue.pop_back();
+                } else {
+                    i++;
+                }
+            }
+        }
+        for (std::vector<Entry>& queue : levels) {
+            if (queue.empty()) continue;
+            size_t best = 0;
+            double best_key = std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < queue.size(); i++) {
+                double key = parameters.priority_weight * queue[i].priority + parameters.size_weight * queue[i].remaining
+                             - parameters.age_weight * (now - queue[i].ready_since);
+                if (key < best_key) {
+                    best_key = key;
+                    best = i;
+                }
+            }
+            int index = queue[best].index;
+            queue[best] = queue.back();
+            queue.pop_back();
+            queued--;
+            return index;
+        }
+        return -1;
+    }
+
+    bool empty() const override { return queued == 0; }
+
+    double timeSlice(int index, double now) override {
+        (void)now;
+        return quantum(level_of[index]);
+    }
+
+    void onTick(int index, double ran, double now) override {
+        (void)now;
+        int& level = level_of[index];
+        if (ran >= quantum(level) - 1e-9 && level + 1 < parameters.levels) level++;
+    }
+
+private:
+    struct Entry {
+        int index;
+        double priority;
+        double remaining;
+        double ready_since;
+    };
+
+    double quantum(int level) const { return parameters.base_quantum * std::pow(parameters.quantum_growth, level); }
+
+    PolicyParameters parameters;
+    std::vector<std::vector<Entry>> levels;
+    std::vector<int> level_of;
+    size_t queued = 0;
+};
+
+/**
+ * Objectives the search minimizes
+ */
+enum TuningObjective {
+    TUNE_MEAN_WAIT,       // Mean waiting time
+    TUNE_P99_RESPONSE,    // 99th percentile response time
+    TUNE_MEAN_SLOWDOWN,   // Mean turnaround / burst
+    TUNE_OBJECTIVES
+};
+
+const char* tuningObjectiveName(TuningObjective objective) {
+    switch (objective) {
+        case TUNE_MEAN_WAIT: return "Mean WT";
+        case TUNE_P99_RESPONSE: return "p99 Response";
+        case TUNE_MEAN_SLOWDOWN: return "Mean Slowdown";
+        case TUNE_OBJECTIVES: break;
+    }
+    return "Unknown";
+}
+
+/**
+ * Scores one run on every objective
+ * @param processes Workload that was simulated
+ * @param result Engine output for that workload
+ * @return One value per TuningObjective (lower is better)
+ */
+std::vector<double> scoreObjectives(const std::vector<Process>& processes, const EngineResult& result) {
+    std::vector<double> scores(TUNE_OBJECTIVES);
+    double slowdown = 0;
+    for (size_t i = 0; i < processes.size(); i++) {
+        slowdown += result.turnaround_time[i] / processes[i].burst_time;
+    }
+    scores[TUNE_MEAN_WAIT] = result.averageWaitingTime();
+    scores[TUNE_P99_RESPONSE] = summarizeLatencies(result.response_time).p99;
+    scores[TUNE_MEAN_SLOWDOWN] = slowdown / processes.size();
+    return scores;
+}
+
+/**
+ * Genetic search over TunablePolicy parameters for one objective
+ * Tournament selection, blend crossover, Gaussian mutation and elitism; every generation's
+ * candidates are evaluated in parallel, each on all of the shared training workloads
+ * @param workloads Training workloads
+ * @param objective Objective to minimize
+ * @param generations Generations to run
+ * @param threads Worker threads evaluating fitness
+ * @param seed Seed of the search (selection, crossover and mutation only run on the calling thread)
+ * @param best_fitness Receives the mean objective value of the returned genome on the workloads
+ * @return Best genome found
+ */
+std::vector<double> geneticPolicySearch(const std::vector<std::vector<Process>>& workloads, TuningObjective objective,
+                                        int generations, int threads, unsigned seed, double& best_fitness) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::normal_distribution<double> jitter(0.0, GA_MUTATION_SIGMA);
+
+    std::vector<std::vector<double>> population(GA_POPULATION, std::vector<double>(TUNE_GENES));
+    for (std::vector<double>& genome : population) {
+        for (double& gene : genome) gene = unit(rng);
+    }
+    std::vector<double> fitness(GA_POPULATION);
+
+    auto evaluate = [&](size_t first) {
+        std::atomic<size_t> next(first);
+        auto worker = [&]() {
+            size_t i;
+            while ((i = next++) < population.size()) {
+                PolicyParameters parameters = decodeGenome(population[i]);
+                double total = 0;
+                for (const std::vector<Process>& processes : workloads) {
+                    TunablePolicy policy(parameters);
+                    total += scoreObjectives(processes, simulateWorkload(processes, policy))[objective];
+                }
+                fitness[i] = total / workloads.size();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (std::thread& thread : pool) thread.join();
+    };
+
+    auto tournament = [&]() {
+        size_t best = rng() % GA_POPULATION;
+        for (int k = 1; k < GA_TOURNAMENT; k++) {
+            size_t challenger = rng() % GA_POPULATION;
+            if (fitness[challenger] < fitness[best]) best = challenger;
+        }
+        return best;
+    };
+
+    evaluate(0);
+    for (int generation = 1; generation < generations; generation++) {
+        std::vector<size_t> ranked(GA_POPULATION);
+        for (int i = 0; i < GA_POPULATION; i++) ranked[i] = i;
+        std::sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b) { return fitness[a] < fitness[b]; });
+
+        // Elites survive unchanged (and keep their fitness); the rest are bred
+        std::vector<std::vector<double>> next_population;
+        std::vector<double> next_fitness;
+        for (int e = 0; e < GA_ELITES; e++) {
+            next_population.push_back(population[ranked[e]]);
+            next_fitness.push_back(fitness[ranked[e]]);
+        }
+        while (static_cast<int>(next_population.size()) < GA_POPULATION) {
+            const std::vector<double>& mother = population[tournament()];
+            const std::vector<double>& father = population[tournament()];
+            std::vector<double> child(TUNE_GENES);
+            for (int g = 0; g < TUNE_GENES; g++) {
+                // BLX-alpha: uniform over the parents' interval widened by GA_BLEND_ALPHA on each side
+                double low = std::min(mother[g], father[g]), high = std::max(mother[g], father[g]);
+                double spread = (high - low) * GA_BLEND_ALPHA;
+                child[g] = low - spread + unit(rng) * (high - low + 2 * spread);
+                if (unit(rng) < GA_MUTATION_RATE) child[g] += jitter(rng);
+                child[g] = std::clamp(child[g], 0.0, 1.0);
+            }
+            next_population.push_back(child);
+        }
+        population.swap(next_population);
+        fitness = next_fitness;
+        fitness.resize(GA_POPULATION);
+        evaluate(GA_ELITES);
+    }
+
+    size_t best = std::min_element(fitness.begin(), fitness.end()) - fitness.begin();
+    best_fitness = fitness[best];
+    return population[best];
+}
+
+/**
+ * Evolutionary Policy Search
+ * Tunes the multilevel feedback policy separately for every workload class and objective,
+ * then checks each tuned configuration on unseen validation workloads against the classic policies
+ * @param generations Generations per search
+ * @return Mean improvement over the best classic policy on validation, in percent
+ */
+double evolutionary_policy_search(int generations) {
+    int threads = std::max(1, std::min(GA_MAX_THREADS, static_cast<int>(std::thread::hardware_concurrency())));
+    const WorkloadClass classes[] = {WORKLOAD_INTERACTIVE, WORKLOAD_BATCH, WORKLOAD_MIXED};
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+
+    std::cout << "\n" << std::string(100, '=') << std::endl;
+    std::cout << "EVOLUTIONARY POLICY SEARCH (population " << GA_POPULATION << ", " << generations << " generations, "
+              << threads << " thread(s))" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Training: " << GA_TRAINING_WORKLOADS << " x " << GA_PROCESS_COUNT << " processes per class; validation on "
+              << GA_VALIDATION_WORKLOADS << " unseen workloads, offered load " << GA_OFFERED_LOAD << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << std::setw(12) << std::left << "Workload" << std::setw(15) << "Objective" << std::right
+              << std::setw(9) << "Train" << std::setw(9) << "Valid" << std::setw(18) << "Best Classic"
+              << std::setw(8) << "Gain" << "  " << std::left << "Parameters" << std::right << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    double total_gain = 0;
+    int searches = 0;
+    for (WorkloadClass workload : classes) {
+        std::vector<std::vector<Process>> training, validation;
+        for (int w = 0; w < GA_TRAINING_WORKLOADS; w++) {
+            training.push_back(generateClassWorkload(workload, GA_PROCESS_COUNT, GA_OFFERED_LOAD, GA_SEED + w));
+        }
+        for (int w = 0; w < GA_VALIDATION_WORKLOADS; w++) {
+            validation.push_back(generateClassWorkload(workload, GA_PROCESS_COUNT, GA_OFFERED_LOAD, GA_SEED + 1000 + w));
+        }
+
+        // Classic policies are scored once per class on every objective
+        std::vector<std::vector<double>> classic(4, std::vector<double>(TUNE_OBJECTIVES, 0));
+        for (int k = 0; k < 4; k++) {
+            for (const std::vector<Process>& processes : validation) {
+                std::vector<double> scores = scoreObjectives(processes, simulateWorkload(processes, *makePolicy(kinds[k])));
+                for (int o = 0; o < TUNE_OBJECTIVES; o++) classic[k][o] += scores[o] / validation.size();
+            }
+        }
+
+        for (int o = 0; o < TUNE_OBJECTIVES; o++) {
+            TuningObjective objective = static_cast<TuningObjective>(o);
+            double train;
+            PolicyParameters best = decodeGenome(
+                geneticPolicySearch(training, objective, generations, threads, GA_SEED + 17 * (static_cast<int>(workload) * TUNE_OBJECTIVES + o), train));
+            double valid = 0;
+            for (const std::vector<Process>& processes : validation) {
+                TunablePolicy policy(best);
+                valid += scoreObjectives(processes, simulateWorkload(processes, policy))[o] / validation.size();
+            }
+            int best_kind = 0;
+            for (int k = 1; k < 4; k++) {
+                if (classic[k][o] < classic[best_kind][o]) best_kind = k;
+            }
+            double gain = 100 * (classic[best_kind][o] - valid) / classic[best_kind][o];
+            total_gain += gain;
+            searches++;
+
+            std::ostringstream classic_label;
+            classic_label << policyKindName(kinds[best_kind]) << " " << std::fixed << std::setprecision(1) << classic[best_kind][o];
+            std::cout << std::setw(12) << std::left << (o == 0 ? workloadClassName(workload) : "")
+                      << std::setw(15) << tuningObjectiveName(objective) << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(9) << train << std::setw(9) << valid << std::setw(18) << classic_label.str()
+                      << std::setw(7) << std::setprecision(1) << gain << "%  " << formatParameters(best) << std::endl;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::string(100, '-') << std::endl;
+    std::cout << "Gain is the validation improvement over the best classic policy for that objective." << std::endl;
+    std::cout << "Parameters: L levels, quantum q x growth per level, boost after waiting, key weights (priority, remaining, wait)" << std::endl;
+    std::cout << "Search time: " << std::setprecision(2) << elapsed.count() << " s" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+
+    return total_gain / searches;
+}
+
+/**
+ * One evaluated configuration in the Pareto exploration
+ */
+struct ParetoPoint {
+    std::string label;          // Classic policy name or "MLFQ"
+    PolicyParameters parameters;
+    bool tunable = false;       // parameters are meaningful
+    double objectives[PARETO_OBJECTIVES];   // Mean WT, p99 response, throughput, Jain fairness, switches
+    int rank = 0;               // 0 = non-dominated
+};
+
+const char* const PARETO_OBJECTIVE_NAMES[PARETO_OBJECTIVES] = {
+    "mean_wait", "p99_response", "throughput", "jain_fairness", "context_switches"
+};
+
+// Throughput and fairness are maximized, the rest minimized
+const bool PARETO_MAXIMIZE[PARETO_OBJECTIVES] = {false, false, true, true, false};
+
+/**
+ * True if a is at least as good as b on every objective and strictly better on one
+ */
+bool paretoDominates(const ParetoPoint& a, const ParetoPoint& b) {
+    bool strictly = false;
+    for (int o = 0; o < PARETO_OBJECTIVES; o++) {
+        double x = PARETO_MAXIMIZE[o] ? -a.objectives[o] : a.objectives[o];
+        double y = PARETO_MAXIMIZE[o] ? -b.objectives[o] : b.objectives[o];
+        if (x > y) return false;
+        if (x < y) strictly = true;
+    }
+    return strictly;
+}
+
+/**
+ * Fast non-dominated sort (Deb et al., NSGA-II): O(M N^2) comparisons, each pair compared once
+ * Sets every point's rank (0 = Pareto front, 1 = front once rank 0 is removed, ...)
+ * @param points Evaluated configurations
+ * @return Number of fronts
+ */
+int nonDominatedSort(std::vector<ParetoPoint>& points) {
+    size_t n = points.size();
+    std::vector<std::vector<size_t>> dominated(n);   // Points each point dominates
+    std::vector<int> dominators(n, 0);               // How many points dominate each point
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            if (paretoDominates(points[i], points[j])) {
+                dominated[i].push_back(j);
+                dominators[j]++;
+            } else if (paretoDominates(points[j], points[i])) {
+                dominated[j].push_back(i);
+                dominators[i]++;
+            }
+        }
+    }
+    std::vector<size_t> front;
+    for (size_t i = 0; i < n; i++) {
+        if (dominators[i] == 0) front.push_back(i);
+    }
+    int rank = 0;
+    while (!front.empty()) {
+        std::vector<size_t> next;
+        for (size_t i : front) {
+            points[i].rank = rank;
+            for (size_t j : dominated[i]) {
+                if (--dominators[j] == 0) next.push_back(j);
+            }
+        }
+        front.swap(next);
+        rank++;
+    }
+    return rank;
+}
+
+/**
+ * Writes every evaluated configuration with its rank as CSV (one row per point)
+ * @param path Output file
+ * @param points Sorted configurations
+ * @return true if the file was written
+ */
+bool exportParetoCsv(const std::string& path, const std::vector<ParetoPoint>& points) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cout << "Could not write Pareto export: " << path << std::endl;
+        return false;
+    }
+    file << "rank,policy";
+    for (const char* name : PARETO_OBJECTIVE_NAMES) file << "," << name;
+    file << ",levels,base_quantum,quantum_growth,boost_wait,priority_weight,size_weight,age_weight\n";
+    for (const ParetoPoint& point : points) {
+        file << point.rank << "," << point.label;
+        for (double value : point.objectives) file << "," << value;
+        if (point.tunable) {
+            const PolicyParameters& p = point.parameters;
+            file << "," << p.levels << "," << p.base_quantum << "," << p.quantum_growth << "," << p.boost_wait
+                 << "," << p.priority_weight << "," << p.size_weight << "," << p.age_weight << "\n";
+        } else {
+            file << ",,,,,,,\n";
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * Pareto Front Exploration
+ * Evaluates the classic policies and many sampled MLFQ configurations in parallel on one shared
+ * workload, ranks them by non-dominated sorting over five objectives and exports the result
+ * @param export_path CSV file to write, or empty to skip the export
+ * @return Size of the Pareto front
+ */
+int pareto_front_exploration(const std::string& export_path) {
+    int threads = std::max(1, std::min(PARETO_MAX_THREADS, static_cast<int>(std::thread::hardware_concurrency())));
+    std::vector<Process> processes = generateClassWorkload(WORKLOAD_MIXED, PARETO_PROCESS_COUNT, PARETO_OFFERED_LOAD, PARETO_SEED);
+    EngineOptions options;
+    options.context_switch_cost = PARETO_SWITCH_COST;
+
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    std::vector<ParetoPoint> points;
+    for (PolicyKind kind : kinds) {
+        ParetoPoint point;
+        point.label = policyKindName(kind);
+        points.push_back(point);
+    }
+    std::mt19937 rng(PARETO_SEED);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (int c = 0; c < PARETO_CONFIGURATIONS; c++) {
+        std::vector<double> genes(TUNE_GENES);
+        for (double& gene : genes) gene = unit(rng);
+        ParetoPoint point;
+        point.label = "MLFQ";
+        point.parameters = decodeGenome(genes);
+        point.tunable = true;
+        points.push_back(point);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t i;
+        while ((i = next++) < points.size()) {
+            ParetoPoint& point = points[i];
+            std::unique_ptr<SchedulerPolicy> policy;
+            if (point.tunable) policy.reset(new TunablePolicy(point.parameters));
+            else policy = makePolicy(kinds[i]);
+            EngineResult result = simulateWorkload(processes, *policy, options);
+
+            point.objectives[0] = result.averageWaitingTime();
+            point.objectives[1] = summarizeLatencies(result.response_time).p99;
+            point.objectives[2] = processes.size() / result.makespan;
+            point.objectives[3] = result.fairness.overall.jainIndex();
+            point.objectives[4] = result.context_switches;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+    for (std::thread& thread : pool) thread.join();
+    std::chrono::duration<double> evaluated = std::chrono::steady_clock::now() - start;
+
+    auto sort_start = std::chrono::steady_clock::now();
+    int fronts = nonDominatedSort(points);
+    std::chrono::duration<double> sorted = std::chrono::steady_clock::now() - sort_start;
+
+    std::vector<const ParetoPoint*> front;
+    for (const ParetoPoint& point : points) {
+        if (point.rank == 0) front.push_back(&point);
+    }
+    std::sort(front.begin(), front.end(), [](const ParetoPoint* a, const ParetoPoint* b) {
+        return a->objectives[0] < b->objectives[0];
+    });
+
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "PARETO FRONT EXPLORATION" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << points.size() << " configurations (4 classic + " << PARETO_CONFIGURATIONS << " sampled MLFQ) on "
+              << PARETO_PROCESS_COUNT << " processes, offered load " << PARETO_OFFERED_LOAD
+              << ", context switch cost " << PARETO_SWITCH_COST << std::endl;
+    std::cout << "Objectives: mean WT (min), p99 response (min), throughput (max), Jain fairness of burst/turnaround (max), switches (min)" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << std::setw(12) << std::left << "Policy" << std::right
+              << std::setw(9) << "Mean WT" << std::setw(9) << "p99 Resp" << std::setw(11) << "Throughput"
+              << std::setw(8) << "Jain" << std::setw(10) << "Switches" << "  " << std::left << "Parameters" << std::right << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    auto printPoint = [](const ParetoPoint& point) {
+        std::cout << std::setw(12) << std::left << point.label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << point.objectives[0] << std::setw(9) << point.objectives[1]
+                  << std::setw(11) << std::setprecision(4) << point.objectives[2]
+                  << std::setw(8) << std::setprecision(3) << point.objectives[3]
+                  << std::setw(10) << std::setprecision(0) << point.objectives[4]
+                  << "  " << (point.tunable ? formatParameters(point.parameters) : "") << std::endl;
+    };
+    // Long fronts are thinned evenly along mean waiting time, keeping both ends
+    size_t shown = std::min(front.size(), static_cast<size_t>(PARETO_DISPLAY_LIMIT));
+    for (size_t k = 0; k < shown; k++) {
+        printPoint(*front[shown > 1 ? k * (front.size() - 1) / (shown - 1) : 0]);
+    }
+    std::cout << std::string(104, '-') << std::endl;
+    std::cout << "Front: " << front.size() << " of " << points.size() << " configurations";
+    if (front.size() > static_cast<size_t>(PARETO_DISPLAY_LIMIT)) std::cout << " (" << PARETO_DISPLAY_LIMIT << " shown)";
+    std::cout << ", " << fronts << " fronts in total" << std::endl;
+    std::cout << "Classic policy ranks:";
+    for (int k = 0; k < 4; k++) std::cout << " " << points[k].label << "=" << points[k].rank;
+    std::cout << "  (0 = on the front)" << std::endl;
+    std::cout << "Evaluation: " << std::setprecision(2) << evaluated.count() << " s on " << threads
+              << " thread(s); sort: " << std::setprecision(2) << sorted.count() * 1e3 << " ms" << std::endl;
+    if (!export_path.empty() && exportParetoCsv(export_path, points)) {
+        std::cout << "All configurations with their rank written to " << export_path
+                  << " (filter rank == 0 for the front)" << std::endl;
+    }
+    std::cout << std::string(104, '=') << std::endl;
+
+    return front.size();
+}
+
+/**
+ * Fairness Analysis
+ * Shows how the classic policies share the CPU: Jain's index, slowdown distribution and the
+ * longest wait without running, overall and for each priority level, all gathered while the engine runs
+ * @param num_processes Arrivals to simulate per policy
+ * @return Jain's index of Priority scheduling
+ */
+double fairness_analysis(int num_processes) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    std::vector<Process> processes = generateArrivalWorkload(num_processes, FAIRNESS_OFFERED_LOAD / mean_burst, FAIRNESS_SEED);
+    const PolicyKind kinds[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+    std::vector<EngineResult> results;
+    for (PolicyKind kind : kinds) {
+        results.push_back(simulateWorkload(processes, *makePolicy(kind)));
+    }
+
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "FAIRNESS ANALYSIS (" << num_processes << " arrivals, offered load " << FAIRNESS_OFFERED_LOAD << ")" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(13) << std::left << "Policy" << std::right
+              << std::setw(9) << "Mean WT" << std::setw(8) << "Jain" << std::setw(10) << "Mean SD"
+              << std::setw(9) << "p99 SD" << std::setw(9) << "Max SD" << std::setw(12) << "Max Starve"
+              << std::setw(10) << "(PID)" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    for (size_t k = 0; k < results.size(); k++) {
+        const FairnessStats& fairness = results[k].fairness;
+        const FairnessGroup& all = fairness.overall;
+        std::cout << std::setw(13) << std::left << policyKindName(kinds[k]) << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(9) << results[k].averageWaitingTime() << std::setw(8) << std::setprecision(3) << all.jainIndex()
+                  << std::setw(10) << std::setprecision(2) << all.meanSlowdown()
+                  << std::setw(9) << std::setprecision(0) << all.slowdownPercentile(0.99)
+                  << std::setw(9) << all.max_slowdown << std::setw(12) << std::setprecision(1) << all.max_starvation
+                  << std::setw(10) << processes[fairness.most_starved].pid << std::endl;
+    }
+
+    std::cout << "\nPer priority level (1 = highest)" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(13) << std::left << "Policy" << std::right << std::setw(6) << "Prio"
+              << std::setw(9) << "Done" << std::setw(10) << "Mean SD" << std::setw(9) << "p95 SD"
+              << std::setw(8) << "Jain" << std::setw(12) << "Max Starve" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    for (size_t k = 0; k < results.size(); k++) {
+        const std::vector<FairnessGroup>& groups = results[k].fairness.by_priority;
+        for (size_t level = 0; level < groups.size(); level++) {
+            std::cout << std::setw(13) << std::left << (level == 0 ? policyKindName(kinds[k]) : "") << std::right
+                      << std::setw(6) << MIN_PRIORITY + static_cast<int>(level) << std::setw(9) << groups[level].completed
+                      << std::setw(10) << std::setprecision(2) << groups[level].meanSlowdown()
+                      << std::setw(9) << std::setprecision(0) << groups[level].slowdownPercentile(0.95)
+                      << std::setw(8) << std::setprecision(3) << groups[level].jainIndex()
+                      << std::setw(12) << std::setprecision(1) << groups[level].max_starvation << std::endl;
+        }
+    }
+
+    std::cout << "\nSlowdown distribution (% of processes)" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(13) << std::left << "Slowdown" << std::right;
+    for (PolicyKind kind : kinds) std::cout << std::setw(13) << policyKindName(kind);
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    for (int b = 0; b < FAIRNESS_SLOWDOWN_BUCKETS; b++) {
+        std::ostringstream range;
+        range << (1L << b) << "-";
+        if (b + 1 < FAIRNESS_SLOWDOWN_BUCKETS) range << (1L << (b + 1));
+        std::cout << std::setw(13) << std::left << range.str() << std::right << std::setprecision(1);
+        for (const EngineResult& result : results) {
+            const FairnessGroup& all = result.fairness.overall;
+            std::cout << std::setw(12) << 100.0 * all.slowdown_histogram[b] / std::max(1L, all.completed) << "%";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << "SD = slowdown (turnaround / burst). Jain's index is over burst / turnaround: 1 = perfectly even." << std::endl;
+    std::cout << "Max Starve = longest continuous wait in the ready queue without running." << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+
+    return results[2].fairness.overall.jainIndex();
+}
+
+/**
+ * Run Telemetry
+ * Runs one policy through a light, an overloaded and a draining phase and samples the engine in
+ * fixed simulated-time windows, showing warm-up, saturation and recovery; the full series is
+ * written column by column for plotting
+ * @param kind Policy to run
+ * @param export_path File for the columnar series, or empty to skip the export
+ * @return Number of windows recorded
+ */
+size_t run_telemetry(PolicyKind kind, const std::string& export_path) {
+    double mean_burst = (MIN_BURST_TIME + MAX_BURST_TIME) / 2.0;
+    std::vector<Process> processes;
+    double offset = 0;
+    for (size_t phase = 0; phase < std::size(TELEMETRY_PHASE_LOADS); phase++) {
+        std::vector<Process> part = generateArrivalWorkload(TELEMETRY_PHASE_PROCESSES,
+                                                            TELEMETRY_PHASE_LOADS[phase] / mean_burst, TELEMETRY_SEED + phase);
+        for (Process& p : part) {
+            processes.emplace_back(processes.size(), p.burst_time, p.priority, offset + p.arrival_time);
+        }
+        offset = processes.back().arrival_time;
+    }
+
+    TelemetrySeries series(TELEMETRY_WINDOW);
+    EngineOptions options;
+    options.telemetry = &series;
+    auto start = std::chrono::steady_clock::now();
+    EngineResult result = simulateWorkload(processes, *makePolicy(kind), options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "RUN TELEMETRY - " << policyKindName(kind) << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << "Phases of " << TELEMETRY_PHASE_PROCESSES << " arrivals at offered load";
+    for (double load : TELEMETRY_PHASE_LOADS) std::cout << " " << load;
+    std::cout << "; " << series.windows() << " windows of " << TELEMETRY_WINDOW << " time units" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(15) << std::left << "Time" << std::right
+              << std::setw(8) << "Arr/t" << std::setw(8) << "Done/t" << std::setw(7) << "Util"
+              << std::setw(9) << "Avg Q" << std::setw(7) << "Max Q" << std::setw(10) << "In-flight"
+              << "  " << std::left << "Avg Q" << std::right << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    // Windows are merged into at most TELEMETRY_DISPLAY_ROWS rows for the screen
+    size_t per_row = std::max<size_t>(1, (series.windows() + TELEMETRY_DISPLAY_ROWS - 1) / TELEMETRY_DISPLAY_ROWS);
+    double peak_queue = 1;
+    for (size_t w = 0; w < series.windows(); w++) peak_queue = std::max(peak_queue, series.queueMean(w));
+    for (size_t first = 0; first < series.windows(); first += per_row) {
+        size_t last = std::min(series.windows(), first + per_row);
+        double arrivals = 0, completions = 0, utilization = 0, queue = 0, in_flight = 0, span = 0;
+        int queue_max = 0;
+        for (size_t w = first; w < last; w++) {
+            double covered = series.windowSpan(w);   // Weights the short last window by what it covers
+            arrivals += series.arrivalCount(w);
+            completions += series.completionCount(w);
+            utilization += series.utilization(w) * covered;
+            queue += series.queueMean(w) * covered;
+            in_flight += series.inFlightMean(w) * covered;
+            queue_max = std::max(queue_max, series.queueMax(w));
+            span += covered;
+        }
+        std::ostringstream range;
+        range << std::fixed << std::setprecision(0) << first * series.windowWidth() << "-" << first * series.windowWidth() + span;
+        std::cout << std::setw(15) << std::left << range.str() << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(8) << arrivals / span << std::setw(8) << completions / span
+                  << std::setw(6) << std::setprecision(0) << 100 * utilization / span << "%"
+                  << std::setw(9) << std::setprecision(1) << queue / span << std::setw(7) << queue_max
+                  << std::setw(10) << in_flight / span << "  "
+                  << std::string(static_cast<size_t>(std::round(TELEMETRY_BAR_WIDTH * queue / span / peak_queue)), '#')
+                  << std::endl;
+    }
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << "Mean waiting time " << std::setprecision(2) << result.averageWaitingTime()
+              << ", makespan " << std::setprecision(0) << result.makespan
+              << ", simulated in " << std::setprecision(3) << elapsed.count() << " s" << std::endl;
+    if (!export_path.empty() && series.writeColumns(export_path)) {
+        std::cout << "Series written to " << export_path << " (one line per metric, one value per window)" << std::endl;
+    }
+    std::cout << std::string(80, '=') << std::endl;
+
+    return series.windows();
+}
+
+#ifdef _WIN32
+typedef SOCKET SocketHandle;
+const SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+const int SEND_FLAGS = 0;
+inline void closeSocket(SocketHandle handle) { closesocket(handle); }
+#else
+typedef int SocketHandle;
+const SocketHandle INVALID_SOCKET_HANDLE = -1;
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;   // A scraper that hangs up early must not raise SIGPIPE and kill the simulator
+#else
+const int SEND_FLAGS = 0;              // macOS: SO_NOSIGPIPE is set on each accepted socket instead
+#endif
+inline void closeSocket(SocketHandle handle) { close(handle); }
+#endif
+
+/**
+ * Escapes a label value for the exposition format (backslash, double quote and newline)
+ * @param value Raw value, such as a policy name from a plugin
+ * @return Text safe to place between the quotes of a label
+ */
+std::string prometheusLabel(const char* value) {
+    std::string escaped;
+    for (; *value; value++) {
+        if (*value == '\\') escaped += "\\\\";
+        else if (*value == '"') escaped += "\\\"";
+        else if (*value == '\n') escaped += "\\n";
+        else escaped += *value;
+    }
+    return escaped;
+}
+
+/**
+ * Renders the registry in the Prometheus text exposition format (version 0.0.4)
+ * Reads only atomics, so it runs concurrently with engine threads without stalling them
+ * @param registry Metrics to render
+ * @param events_per_second Dispatch rate since the previous scrape
+ * @return Exposition text
+ */
+std::string renderPrometheusMetrics(MetricsRegistry& registry, double events_per_second) {
+    std::ostringstream out;
+    out << std::setprecision(15);
+    std::vector<const PolicyMetrics*> ready;
+    for (const PolicyMetrics& slot : registry.policies) {
+        if (slot.state.load(std::memory_order_acquire) == 2) ready.push_back(&slot);
+    }
+    auto family = [&](const char* name, const char* type, const char* help) {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+    };
+    auto perPolicy = [&](const char* name, const char* type, const char* help, auto value) {
+        family(name, type, help);
+        for (const PolicyMetrics* slot : ready) {
+            out << name << "{policy=\"" << prometheusLabel(slot->name) << "\"} " << value(*slot) << "\n";
+        }
+    };
+    const auto relaxed = std::memory_order_relaxed;
+
+    family("scheduler_scrapes_total", "counter", "Scrapes served by this endpoint.");
+    out << "scheduler_scrapes_total " << registry.scrapes.load(relaxed) << "\n";
+    family("scheduler_events_per_second", "gauge", "Engine dispatches per wall-clock second since the previous scrape.");
+    out << "scheduler_events_per_second " << events_per_second << "\n";
+    perPolicy("scheduler_engine_runs_total", "counter", "Engine runs started.",
+              [&](const PolicyMetrics& m) { return m.runs.load(relaxed); });
+    perPolicy("scheduler_events_total", "counter", "Dispatch decisions (slices run).",
+              [&](const PolicyMetrics& m) { return m.dispatches.load(relaxed); });
+    perPolicy("scheduler_processes_completed_total", "counter", "Processes run to completion.",
+              [&](const PolicyMetrics& m) { return m.completions.load(relaxed); });
+    perPolicy("scheduler_context_switches_total", "counter", "Switches between different processes.",
+              [&](const PolicyMetrics& m) { return m.context_switches.load(relaxed); });
+    perPolicy("scheduler_simulated_time_total", "counter", "Simulated time units advanced.",
+              [&](const PolicyMetrics& m) { return m.simulated_time.load(relaxed); });
+    perPolicy("scheduler_queue_depth", "gauge", "Ready-queue length at the latest engine flush.",
+              [&](const PolicyMetrics& m) { return m.queue_depth.load(relaxed); });
+
+    family("scheduler_waiting_time", "histogram", "Waiting time of completed processes in simulated time units.");
+    for (const PolicyMetrics* slot : ready) {
+        std::string label = prometheusLabel(slot->name);
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b <= std::size(PROMETHEUS_WAIT_BUCKETS); b++) {
+            cumulative += slot->wait_buckets[b].load(relaxed);
+            out << "scheduler_waiting_time_bucket{policy=\"" << label << "\",le=\"";
+            if (b < std::size(PROMETHEUS_WAIT_BUCKETS)) out << PROMETHEUS_WAIT_BUCKETS[b];
+            else out << "+Inf";
+            out << "\"} " << cumulative << "\n";
+        }
+        out << "scheduler_waiting_time_sum{policy=\"" << label << "\"} " << slot->wait_sum.load(relaxed) << "\n";
+        out << "scheduler_waiting_time_count{policy=\"" << label << "\"} " << cumulative << "\n";
+    }
+    return out.str();
+}
+
+/**
+ * Minimal HTTP server answering GET /metrics on a background thread
+ * Listens on the loopback interface only; one request per connection
+ */
+class MetricsServer {
+public:
+    ~MetricsServer() { stop(); }
+
+    bool running() const { return worker.joinable(); }
+    int port() const { return listening_port; }
+
+    /**
+     * Opens the listening socket and starts serving
+     * @param port TCP port on 127.0.0.1
+     * @return true if the endpoint is up
+     */
+    bool start(int port) {
+        if (running()) return true;
+#ifdef _WIN32
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+            std::cout << "Could not initialize Winsock" << std::endl;
+            return false;
+        }
+#endif
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener == INVALID_SOCKET_HANDLE) {
+            std::cout << "Could not create the metrics socket" << std::endl;
+            cleanup();
+            return false;
+        }
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0) {
+            std::cout << "Could not listen on 127.0.0.1:" << port << std::endl;
+            cleanup();
+            return false;
+        }
+        listening_port = port;
+        stopping = false;
+        last_scrape = std::chrono::steady_clock::now();
+        last_events = 0;
+        metricsRegistry().enabled.store(true);
+        worker = std::thread([this]() { serve(); });
+        return true;
+    }
+
+    void stop() {
+        if (!running()) return;
+        stopping = true;
+        worker.join();
+        metricsRegistry().enabled.store(false);
+        cleanup();
+    }
+
+private:
+    void cleanup() {
+        if (listener != INVALID_SOCKET_HANDLE) closeSocket(listener);
+        listener = INVALID_SOCKET_HANDLE;
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    // Waits up to PROMETHEUS_POLL_MS for the socket to become readable
+    static bool readable(SocketHandle handle) {
+        fd_set set;
+        FD_ZERO(&set);
+        FD_SET(handle, &set);
+        timeval timeout = {0, PROMETHEUS_POLL_MS * 1000};
+        return select(static_cast<int>(handle) + 1, &set, nullptr, nullptr, &timeout) > 0;
+    }
+
+    void serve() {
+        while (!stopping) {
+            if (!readable(listener)) continue;
+            SocketHandle client = accept(listener, nullptr, nullptr);
+            if (client == INVALID_SOCKET_HANDLE) continue;
+#ifdef SO_NOSIGPIPE
+            int no_sigpipe = 1;
+            setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos && request.size() < PROMETHEUS_MAX_REQUEST && readable(client)) {
+                int received = recv(client, buffer, sizeof(buffer), 0);
+                if (received <= 0) break;
+                request.append(buffer, received);
+            }
+            respond(client, request);
+            closeSocket(client);
+        }
+    }
+
+    void respond(SocketHandle client, const std::string& request) {
+        std::string status = "200 OK", body;
+        if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 13, "GET /metrics?") == 0) {
+            MetricsRegistry& registry = metricsRegistry();
+            registry.scrapes.fetch_add(1, std::memory_order_relaxed);
+            uint64_t events = 0;
+            for (const PolicyMetrics& slot : registry.policies) events += slot.dispatches.load(std::memory_order_relaxed);
+            auto now = std::chrono::steady_clock::now();
+            std::chrono::duration<double> elapsed = now - last_scrape;
+            double rate = elapsed.count() > 0 ? (events - last_events) / elapsed.count() : 0;
+            last_scrape = now;
+            last_events = events;
+            body = renderPrometheusMetrics(registry, rate);
+        } else {
+            status = "404 Not Found";
+            body = "Metrics are served at /metrics\n";
+        }
+        std::ostringstream response;
+        response << "HTTP/1.1 " << status << "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: "
+                 << body.size() << "\r\nConnection: close\r\n\r\n" << body;
+        std::string text = response.str();
+        size_t sent = 0;
+        while (sent < text.size()) {
+            int written = send(client, text.data() + sent, static_cast<int>(text.size() - sent), SEND_FLAGS);
+            if (written <= 0) break;
+            sent += written;
+        }
+    }
+
+    std::thread worker;
+    std::atomic<bool> stopping{false};
+    SocketHandle listener = INVALID_SOCKET_HANDLE;
+    int listening_port = 0;
+    std::chrono::steady_clock::time_point last_scrape;   // Only touched by the server thread after start
+    uint64_t last_events = 0;
+};
+
+/**
+ * Metrics Endpoint
+ * Starts or stops the Prometheus endpoint; while it is up, every engine run from any menu option
+ * publishes its counters, so long simulations can be watched with curl or a Prometheus server
+ * @param server Process-wide server instance
+ * @param port Port to listen on when starting
+ * @return true if the endpoint is running afterwards
+ */
+bool metrics_endpoint(MetricsServer& server, int port) {
+    std::cout << "\n" << std::string(60, '=') << std::endl;
+    std::cout << "METRICS ENDPOINT" << std::endl;
+    std::cout << std::string(60, '=') << std::endl;
+    if (server.running()) {
+        int was = server.port();
+        server.stop();
+        std::cout << "Stopped serving on 127.0.0.1:" << was << std::endl;
+    } else if (server.start(port)) {
+        std::cout << "Serving Prometheus metrics at http://127.0.0.1:" << port << "/metrics" << std::endl;
+        std::cout << "Engine runs started from any option are now published; choose this option again to stop." << std::endl;
+        std::cout << "Example: curl -s http://127.0.0.1:" << port << "/metrics" << std::endl;
+    }
+    std::cout << std::string(60, '=') << std::endl;
+    return server.running();
+}
+
+/**
+ * Clears a failed numeric read and drops the rest of the typed line
+ * The newline itself is left for the "Press Enter to continue" pause that follows every option
+ */
+void discardRejectedInput() {
+    std::cin.clear();
+    while (std::cin.peek() != '\n' && std::cin.peek() != EOF) {
+        std::cin.get();
+    }
+}
+
+/**
+ * Main function - Interactive CPU Scheduling Simulator
+ * Provides a menu-driven interface to test different scheduling algorithms
+ */
+int main() {
+    srand(time(nullptr));
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << "                    CPU SCHEDULING ALGORITHM SIMULATOR" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << "This program demonstrates various CPU scheduling algorithms used in operating systems." << std::endl;
+    std::cout << "Processes are generated with random burst times and priorities for testing." << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+
+    std::vector<Process> processes = generateProcesses(DEFAULT_PROCESS_COUNT);
+    std::cout << "\nGenerated " << DEFAULT_PROCESS_COUNT << " random processes for testing." << std::endl;
+    MetricsServer metrics_server;   // Optional Prometheus endpoint (menu option 31)
+
+    while(true) {
+        int choice;
+        do {
+            std::cout << "\n" << std::string(60, '=') << std::endl;
+            std::cout << "                    SCHEDULING ALGORITHMS MENU" << std::endl;
+            std::cout << std::string(60, '=') << std::endl;
+            std::cout << "1. First Come First Served (FCFS)" << std::endl;
+            std::cout << "2. Shortest Job First (SJF)" << std::endl;
+            std::cout << "3. Priority Scheduling" << std::endl;
+            std::cout << "4. Round Robin (RR)" << std::endl;
+            std::cout << "5. Multilevel Queue Scheduling" << std::endl;
+            std::cout << "6. Multi-Core Scheduling (SMT & Cache Affinity)" << std::endl;
+            std::cout << "7. Hierarchical Fair-Share Scheduling" << std::endl;
+            std::cout << "10. Two-Level Hypervisor Scheduling (vCPU on pCPU)" << std::endl;
+            std::cout << "11. Gang Scheduling for Parallel Jobs" << std::endl;
+            std::cout << "12. Disk I/O Request Scheduling" << std::endl;
+            std::cout << "13. Network Packet Scheduling (DRR, WFQ, Priority)" << std::endl;
+            std::cout << "14. Memory Paging and Thrashing" << std::endl;
+            std::cout << "15. Admission Control and Overload Shedding" << std::endl;
+            std::cout << "16. Tickless vs Periodic-Tick Timers" << std::endl;
+            std::cout << "17. Interrupt and SoftIRQ Load (Multi-Core)" << std::endl;
+            std::cout << "18. Green-Thread Executor (Real Execution)" << std::endl;
+            std::cout << "19. Coroutine Behavioral Workloads" << std::endl;
+            std::cout << "20. Optimality Gap (Branch and Bound)" << std::endl;
+            std::cout << "21. Analytic Queueing Prediction vs Simulation" << std::endl;
+            std::cout << "22. Variance Reduction (CRN, Antithetic, Control Variates)" << std::endl;
+            std::cout << "23. Adaptive Replication and Batch Means" << std::endl;
+            std::cout << "24. Significance Testing (Bootstrap, Permutation)" << std::endl;
+            std::cout << "25. Load Policy Plugin" << std::endl;
+            std::cout << "26. Policy Expression Language (DSL)" << std::endl;
+            std::cout << "27. Evolutionary Policy Search" << std::endl;
+            std::cout << "28. Pareto Front Exploration" << std::endl;
+            std::cout << "29. Fairness Analysis" << std::endl;
+            std::cout << "30. Run Telemetry" << std::endl;
+            std::cout << "31. Start/Stop Metrics Endpoint" << std::endl;
+            std::cout << std::string(60, '-') << std::endl;
+            std::cout << "8. Display Current Processes" << std::endl;
+            std::cout << "9. Generate New Processes" << std::endl;
+            std::cout << "0. Exit Program" << std::endl;
+            std::cout << std::string(60, '=') << std::endl;
+            std::cout << "Enter your choice (0-31): ";
+            std::cin >> choice;
+
+            // Input validation
+            if (std::cin.fail() || choice < 0 || choice > 31) {
+                std::cout << "\nInvalid option! Please enter a valid choice (0-31)." << std::endl;
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            }
+
+        } while (std::cin.fail() || choice < 0 || choice > 31);
+
+        bool line_consumed = false;   // Set when an option already read its input up to the newline
+        switch (choice) {
+            case 1:
+                first_come_first_served(processes);
+                break;
+            case 2:
+                shortest_job_first(processes);
+                break;
+            case 3:
+                priority_scheduling(processes);
+                break;
+            case 4:
+                round_robin(processes);
+                break;
+            case 5:
+                multilevel_queue_scheduling(processes);
+                break;
+            case 6: {
+                std::string path;
+                std::cout << "\nEnter topology file path (or '-' for the built-in machine): ";
+                std::cin >> path;
+                MachineTopology topology = buildTopology(NUM_SOCKETS, CORES_PER_SOCKET, THREADS_PER_CORE);
+                if (path != "-" && !loadTopologyFile(path, topology)) {
+                    std::cout << "Using the built-in machine instead." << std::endl;
+                }
+                multi_core_scheduling(generateProcesses(topology.cpus.size() * PROCESSES_PER_CPU), topology);
+                break;
+            }
+            case 7:
+                hierarchical_fair_share_scheduling(processes);
+                break;
+            case 10: {
+                const PolicyKind guest_policies[] = {POLICY_FCFS, POLICY_SJF, POLICY_PRIORITY, POLICY_RR};
+                std::vector<VirtualMachine> vms;
+                for (int v = 0; v < HYPERVISOR_VMS; v++) {
+                    vms.push_back(VirtualMachine{guest_policies[v % 4], VCPUS_PER_VM, generateProcesses(PROCESSES_PER_VM, rand())});
+                }
+                hypervisor_scheduling(vms);
+                break;
+            }
+            case 11: {
+                int num_cpus = NUM_SOCKETS * CORES_PER_SOCKET * THREADS_PER_CORE;
+                gang_scheduling(generateParallelJobs(GANG_JOB_COUNT, num_cpus / 2), num_cpus);
+                break;
+            }
+            case 12:
+                disk_io_scheduling(generateDiskRequests(DISK_REQUEST_COUNT, rand()));
+                break;
+            case 13: {
+                long num_packets;
+                std::cout << "\nEnter packets to simulate per discipline (0 for " << DEFAULT_PACKET_COUNT << "): ";
+                std::cin >> num_packets;
+                if (std::cin.fail() || num_packets <= 0) {
+                    discardRejectedInput();
+                    num_packets = DEFAULT_PACKET_COUNT;
+                }
+                packet_scheduling(generateFlows(PACKET_FLOWS), num_packets);
+                break;
+            }
+            case 14: {
+                std::vector<Process> workload = generateProcesses(PAGING_PROCESS_COUNT);
+                paging_simulation(workload, generateMemoryProfiles(workload));
+                break;
+            }
+            case 15: {
+                int scheduler;
+                std::cout << "\nScheduler behind admission control (1 = FCFS, 2 = SJF, 3 = Priority, 4 = RR): ";
+                std::cin >> scheduler;
+                if (std::cin.fail() || scheduler < 1 || scheduler > 4) {
+                    discardRejectedInput();
+                    scheduler = 1;
+                }
+                admission_control(static_cast<PolicyKind>(scheduler - 1));
+                break;
+            }
+            case 16:
+                timer_modeling(QUANTUM);
+                break;
+            case 17: {
+                MachineTopology topology = buildTopology(NUM_SOCKETS, CORES_PER_SOCKET, THREADS_PER_CORE);
+                interrupt_load_simulation(generateProcesses(topology.cpus.size() * PROCESSES_PER_CPU), topology);
+                break;
+            }
+            case 18:
+                green_thread_execution(processes);
+                break;
+            case 19:
+                behavioral_workload_simulation(BEHAVIOR_PROCESS_COUNT);
+                break;
+            case 20: {
+                int count;
+                std::cout << "\nEnter processes per workload (up to " << BNB_MAX_PROCESSES
+                          << ", 0 for " << BNB_DEFAULT_PROCESSES << "): ";
+                std::cin >> count;
+                if (std::cin.fail() || count <= 0 || count > BNB_MAX_PROCESSES) {
+                    discardRejectedInput();
+                    count = BNB_DEFAULT_PROCESSES;
+                }
+                optimality_gap_analysis(count);
+                break;
+            }
+            case 21:
+                analytic_prediction(ANALYTIC_PROCESS_COUNT);
+                break;
+            case 22:
+                variance_reduction_study(VR_REPLICATIONS);
+                break;
+            case 23: {
+                double percent;
+                std::cout << "\nEnter target half-width in percent of the mean (0 for "
+                          << 100 * ADAPTIVE_TARGET_WIDTH << "): ";
+                std::cin >> percent;
+                if (std::cin.fail() || percent <= 0) {
+                    discardRejectedInput();
+                    percent = 100 * ADAPTIVE_TARGET_WIDTH;
+                }
+                adaptive_replication(percent / 100);
+                break;
+            }
+            case 24:
+                significance_testing(STAT_REPLICATIONS, STAT_RESAMPLES);
+                break;
+            case 25: {
+                std::string spec;
+                std::cout << "\nEnter plugin path (optionally followed by ?options): ";
+                std::cin >> spec;
+                plugin_policy_comparison(spec);
+                break;
+            }
+            case 26: {
+                std::string key_source, preempt_source;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "\nVariables: priority burst remaining arrival age wait run now; functions: min max abs" << std::endl;
+                std::cout << "Enter selection key, highest runs first (empty for " << DSL_DEFAULT_KEY << "): ";
+                std::getline(std::cin, key_source);
+                std::cout << "Enter preemption condition ('-' for none, empty for " << DSL_DEFAULT_PREEMPT << "): ";
+                std::getline(std::cin, preempt_source);
+                line_consumed = true;
+                if (key_source.empty()) key_source = DSL_DEFAULT_KEY;
+                if (preempt_source.empty()) preempt_source = DSL_DEFAULT_PREEMPT;
+                else if (preempt_source == "-") preempt_source.clear();
+                policy_dsl_experiment(key_source, preempt_source);
+                break;
+            }
+            case 27: {
+                int generations;
+                std::cout << "\nEnter generations per search (0 for " << GA_DEFAULT_GENERATIONS << "): ";
+                std::cin >> generations;
+                if (std::cin.fail() || generations <= 0) {
+                    discardRejectedInput();
+                    generations = GA_DEFAULT_GENERATIONS;
+                }
+                evolutionary_policy_search(generations);
+                break;
+            }
+            case 28: {
+                std::string path;
+                std::cout << "\nEnter CSV file for the export (0 for " << PARETO_EXPORT_PATH << ", - to skip): ";
+                std::cin >> path;
+                if (path == "0") path = PARETO_EXPORT_PATH;
+                else if (path == "-") path.clear();
+                pareto_front_exploration(path);
+                break;
+            }
+            case 29: {
+                int num_processes;
+                std::cout << "\nEnter arrivals per policy (0 for " << FAIRNESS_PROCESS_COUNT << "): ";
+                std::cin >> num_processes;
+                if (std::cin.fail() || num_processes <= 0) {
+                    discardRejectedInput();
+                    num_processes = FAIRNESS_PROCESS_COUNT;
+                }
+                fairness_analysis(num_processes);
+                break;
+            }
+            case 30: {
+                int scheduler;
+                std::string path;
+                std::cout << "\nScheduler to observe (1 = FCFS, 2 = SJF, 3 = Priority, 4 = RR): ";
+                std::cin >> scheduler;
+                if (std::cin.fail() || scheduler < 1 || scheduler > 4) {
+                    discardRejectedInput();
+                    scheduler = 1;
+                }
+                std::cout << "Enter file for the series (0 for " << TELEMETRY_EXPORT_PATH << ", - to skip): ";
+                std::cin >> path;
+                if (path == "0") path = TELEMETRY_EXPORT_PATH;
+                else if (path == "-") path.clear();
+                run_telemetry(static_cast<PolicyKind>(scheduler - 1), path);
+                break;
+            }
+            case 31: {
+                int port = PROMETHEUS_DEFAULT_PORT;
+                if (!metrics_server.running()) {
+                    std::cout << "\nEnter port (0 for " << PROMETHEUS_DEFAULT_PORT << "): ";
+                    std::cin >> port;
+                    if (std::cin.fail() || port <= 0 || port > 65535) {
+                        discardRejectedInput();
+                        port = PROMETHEUS_DEFAULT_PORT;
+                    }
+                }
+                metrics_endpoint(metrics_server, port);
+                break;
+            }
             case 8:
                 displayProcesses(processes);
                 break;
@@ -523,7 +8303,7 @@ int main() {
         
         // Pause before showing menu again
         std::cout << "\nPress Enter to continue...";
-        std::cin.ignore();
+        if (!line_consumed) std::cin.ignore();
         std::cin.get();
     }
 
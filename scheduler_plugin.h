@@ -0,0 +1,93 @@
+/*
+ * Scheduling policy plugin ABI
+ *
+ * A plugin is a shared library (.so / .dylib / .dll) exporting one C function,
+ * sched_plugin_entry(), that returns a table of callbacks. The simulator only
+ * talks to the plugin through this table, so plugins can be written in C or any
+ * language with a C FFI and rebuilt without touching main.cpp.
+ *
+ * Calls are batched: ready processes, tick reports and completions that occur
+ * between two scheduling decisions are delivered as arrays just before the next
+ * pick_next call, so one decision costs a handful of calls across the boundary.
+ * Within a batch flush, ticks are delivered first, then completions, then enqueues.
+ *
+ * The ABI is versioned; a plugin built against a different SCHED_PLUGIN_ABI_VERSION
+ * is rejected at load time. New fields are only ever appended to the structs.
+ */
+#ifndef SCHEDULER_PLUGIN_H
+#define SCHEDULER_PLUGIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_PLUGIN_ABI_VERSION 1
+#define SCHED_PLUGIN_ENTRY_SYMBOL "sched_plugin_entry"
+
+#if defined(_WIN32)
+#define SCHED_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define SCHED_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* A process that became ready (arrival or preemption) */
+typedef struct sched_task {
+    int32_t index;          /* Identifies the process in every later call */
+    int32_t pid;
+    int32_t priority;       /* Lower number = higher priority */
+    int32_t burst_time;     /* Total CPU time the process needs */
+    double arrival_time;
+    double remaining;       /* CPU time still required */
+} sched_task;
+
+/* A process ran for 'ran' time units ending at 'now' */
+typedef struct sched_tick {
+    int32_t index;
+    double ran;
+    double now;
+} sched_tick;
+
+/* A process finished at 'now' */
+typedef struct sched_completion {
+    int32_t index;
+    double now;
+} sched_completion;
+
+typedef struct sched_plugin_api {
+    uint32_t abi_version;   /* Must be SCHED_PLUGIN_ABI_VERSION */
+    const char* name;       /* Display name */
+
+    /* Used when time_slice is NULL: maximum run per dispatch (0 = until completion) */
+    double default_time_slice;
+
+    /* Creates the policy state; options is the text after '?' in the plugin path (may be empty).
+       Returning NULL rejects the plugin and the load fails */
+    void* (*init)(const char* options);
+    void (*destroy)(void* state);
+
+    /* Required: batched events */
+    void (*enqueue)(void* state, const sched_task* tasks, size_t count, double now);
+    void (*on_tick)(void* state, const sched_tick* ticks, size_t count);
+    void (*on_complete)(void* state, const sched_completion* completions, size_t count);
+
+    /* Removes and returns the index of the next process to run, or -1 if none may run at 'now'.
+       The host stops the run if the index is not one it enqueued and the plugin still holds, or if
+       -1 comes back with processes queued and next_eligible_time does not name a later time */
+    int32_t (*pick_next)(void* state, double now);
+
+    /* Optional (may be NULL): per-dispatch slice and earliest time a throttled process may run */
+    double (*time_slice)(void* state, int32_t index, double now);
+    double (*next_eligible_time)(void* state, double now);
+} sched_plugin_api;
+
+/* Signature of the exported entry point */
+typedef const sched_plugin_api* (*sched_plugin_entry_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDULER_PLUGIN_H */